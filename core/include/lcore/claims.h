@@ -0,0 +1,112 @@
+#ifndef LCORE_CLAIMS_H
+#define LCORE_CLAIMS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Allocation-free writer for a flat JSON object of sensor claims.
+ *
+ * Fields are appended in order into a caller-provided buffer. In Base64URL
+ * mode the JSON text is encoded as it is written, so a reading can be placed
+ * into a JWS payload in one pass (see lcore_jose_claims_init()).
+ *
+ * Members are private; the structure is public only so it can live on the stack.
+ * Once an append fails the writer stays failed and lcore_claims_finish()
+ * reports the first error. After lcore_claims_finish() the writer is closed:
+ * appends fail with -1 and it must be initialized again to write a new object.
+ */
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t len;
+    size_t count;
+    int base64url;
+    uint8_t carry[3];
+    size_t carry_len;
+    int error;
+    int finished;
+} lcore_claims_t;
+
+/**
+ * @brief Starts a JSON object in the given buffer.
+ *
+ * @param[out] claims The writer to initialize.
+ * @param[out] buffer The buffer to write the JSON text to.
+ * @param[in] size The size of the buffer.
+ */
+void lcore_claims_init(lcore_claims_t* claims, char* buffer, size_t size);
+
+/**
+ * @brief Starts a JSON object whose text is written Base64URL encoded (without padding).
+ *
+ * @param[out] claims The writer to initialize.
+ * @param[out] buffer The buffer to write the encoded text to.
+ * @param[in] size The size of the buffer.
+ */
+void lcore_claims_init_b64url(lcore_claims_t* claims, char* buffer, size_t size);
+
+/**
+ * @brief Appends an integer field.
+ *
+ * @param[in,out] claims The writer.
+ * @param[in] name The field name.
+ * @param[in] value The value.
+ * @return 0 on success, -1 on invalid parameters, -2 if the buffer is too small.
+ */
+int lcore_claims_add_int(lcore_claims_t* claims, const char* name, int64_t value);
+
+/**
+ * @brief Appends a number rounded to a fixed number of decimals.
+ *
+ * Trailing zeros are dropped, so 25.10 with 2 decimals is written as 25.1 and
+ * 48.0 as 48. Formatting is independent of the C locale.
+ *
+ * @param[in,out] claims The writer.
+ * @param[in] name The field name.
+ * @param[in] value The value; must be finite.
+ * @param[in] decimals The sensor resolution in decimal digits, at most 9.
+ * @return 0 on success, -1 on invalid parameters or out-of-range value, -2 if the buffer is too small.
+ */
+int lcore_claims_add_double(lcore_claims_t* claims, const char* name, double value, unsigned decimals);
+
+/**
+ * @brief Appends a string field, escaping it as required by JSON.
+ *
+ * @param[in,out] claims The writer.
+ * @param[in] name The field name.
+ * @param[in] value The NUL-terminated value.
+ * @return 0 on success, -1 on invalid parameters, -2 if the buffer is too small.
+ */
+int lcore_claims_add_string(lcore_claims_t* claims, const char* name, const char* value);
+
+/**
+ * @brief Appends a boolean field.
+ *
+ * @param[in,out] claims The writer.
+ * @param[in] name The field name.
+ * @param[in] value Zero for false, non-zero for true.
+ * @return 0 on success, -1 on invalid parameters, -2 if the buffer is too small.
+ */
+int lcore_claims_add_bool(lcore_claims_t* claims, const char* name, int value);
+
+/**
+ * @brief Closes the object and NUL-terminates the buffer.
+ *
+ * Calling it again does not modify the buffer and returns the same result and length.
+ *
+ * @param[in,out] claims The writer.
+ * @param[out] len Optional, set to the number of characters written (excluding the terminator).
+ * @return 0 on success, -1 on invalid parameters, -2 if the buffer is too small.
+ */
+int lcore_claims_finish(lcore_claims_t* claims, size_t* len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LCORE_CLAIMS_H
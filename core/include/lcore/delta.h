@@ -0,0 +1,112 @@
+#ifndef LCORE_DELTA_H
+#define LCORE_DELTA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Limits of the delta codec context.
+ */
+#define LCORE_DELTA_MAX_FIELDS 16
+#define LCORE_DELTA_MAX_NAME 32
+#define LCORE_DELTA_MAX_STRING 32
+
+/**
+ * @brief One field of the last reading, as remembered by the codec.
+ *
+ * Members are private.
+ */
+typedef struct {
+    char name[LCORE_DELTA_MAX_NAME];
+    uint8_t type;
+    uint8_t decimals;
+    int64_t value;
+    char text[LCORE_DELTA_MAX_STRING];
+} lcore_delta_field_t;
+
+/**
+ * @brief Delta codec state for one device stream.
+ *
+ * The encoder and the decoder each keep a context. A keyframe carries the
+ * field names, types and absolute values; later frames carry only the change
+ * of each field against the previous reading, in the keyframe's field order.
+ *
+ * Members are private; the structure is public only so it can live on the stack.
+ */
+typedef struct {
+    lcore_delta_field_t fields[LCORE_DELTA_MAX_FIELDS];
+    size_t field_count;
+    uint8_t sequence;
+    int primed;
+    unsigned keyframe_interval;
+    unsigned since_keyframe;
+} lcore_delta_ctx_t;
+
+/**
+ * @brief Initializes a codec context.
+ *
+ * @param[out] ctx The context to initialize.
+ * @param[in] keyframe_interval Emit a keyframe at least every this many frames, 0 to send one only when the fields change.
+ */
+void lcore_delta_init(lcore_delta_ctx_t* ctx, unsigned keyframe_interval);
+
+/**
+ * @brief Forces the next encoded frame to be a keyframe.
+ *
+ * Call this when the receiver reports that it lost the stream.
+ *
+ * @param[in,out] ctx The encoder context.
+ */
+void lcore_delta_reset(lcore_delta_ctx_t* ctx);
+
+/**
+ * @brief Encodes a flat JSON reading into a compact binary frame for lcore_jose_sign().
+ *
+ * Supported values are numbers without exponent (at most 15 significant digits
+ * and 9 decimals), strings without escapes, true and false. Readings outside
+ * this subset are rejected and should be signed as plain JSON.
+ *
+ * @param[in,out] ctx The encoder context, updated only on success.
+ * @param[in] json The JSON object.
+ * @param[in] json_len The length of the JSON text.
+ * @param[out] frame The buffer to write the frame to.
+ * @param[in,out] frame_len The size of the buffer, updated with the actual size.
+ * @return 0 on success, -1 on unsupported input, -2 if the buffer is too small.
+ */
+int lcore_delta_encode(
+    lcore_delta_ctx_t* ctx,
+    const char* json,
+    size_t json_len,
+    uint8_t* frame,
+    size_t* frame_len
+);
+
+/**
+ * @brief Decodes a frame produced by lcore_delta_encode() back into JSON.
+ *
+ * Numbers are written in canonical form, so 25.10 comes back as 25.1.
+ *
+ * @param[in,out] ctx The decoder context, updated only on success.
+ * @param[in] frame The frame, typically the payload returned by lcore_jose_verify().
+ * @param[in] frame_len The length of the frame.
+ * @param[out] json The buffer to write the NUL-terminated JSON to.
+ * @param[in,out] json_len The size of the buffer, updated with the JSON length.
+ * @return 0 on success, -1 on a malformed frame, -2 if the buffer is too small, -3 if a delta frame does not follow the previous frame (a keyframe is needed).
+ */
+int lcore_delta_decode(
+    lcore_delta_ctx_t* ctx,
+    const uint8_t* frame,
+    size_t frame_len,
+    char* json,
+    size_t* json_len
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LCORE_DELTA_H
@@ -7,6 +7,8 @@ extern "C" {
 
 #include <stddef.h>
 #include <stdint.h>
+#include <lcore/claims.h>
+#include <lcore/key.h>
 
 /**
  * @brief Supported JOSE signing algorithms.
@@ -38,6 +40,72 @@ int lcore_jose_sign(
     size_t* buffer_len
 );
 
+/**
+ * @brief Signs a payload with a key held in persistent storage.
+ *
+ * Same as lcore_jose_sign(), but the key is referenced by the id it was
+ * provisioned under with lcore_key_provision(), so it is not imported again
+ * on every call.
+ *
+ * @param[in] payload The data to sign.
+ * @param[in] payload_len The length of the data.
+ * @param[in] key_id The id of the stored private key.
+ * @param[in] alg The signing algorithm to use.
+ * @param[out] buffer The buffer to write the JWS to.
+ * @param[in,out] buffer_len The size of the buffer, updated with the actual size.
+ * @return 0 on success, non-zero on failure.
+ */
+int lcore_jose_sign_with_key(
+    const uint8_t* payload,
+    size_t payload_len,
+    lcore_key_id_t key_id,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t* buffer_len
+);
+
+/**
+ * @brief Starts a JWS whose payload is written with the claims writer.
+ *
+ * The header is placed in @p buffer and the claims appended afterwards are
+ * Base64URL encoded straight into the payload segment, so the reading is never
+ * held as plain JSON.
+ *
+ * @param[out] claims The writer to initialize.
+ * @param[in] alg The signing algorithm to use.
+ * @param[out] buffer The buffer the complete JWS will be written to.
+ * @param[in] buffer_len The size of the buffer.
+ * @return 0 on success, -2 if the buffer cannot hold the header, other non-zero values on failure.
+ */
+int lcore_jose_claims_init(
+    lcore_claims_t* claims,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t buffer_len
+);
+
+/**
+ * @brief Closes the claims started by lcore_jose_claims_init() and signs them.
+ *
+ * The writer is closed even if signing fails. After -2, initialize it again
+ * with a buffer of at least *jws_len bytes and rewrite the claims. If the
+ * buffer given to lcore_jose_claims_init() could not hold the header, *jws_len
+ * is the smallest usable size; if the claims themselves did not fit, it is
+ * left unchanged.
+ *
+ * @param[in,out] claims The writer holding the header and payload.
+ * @param[in] private_key The private key to sign with.
+ * @param[in] key_len The length of the private key.
+ * @param[out] jws_len Set to the length of the JWS, or to the required buffer size if it is too small.
+ * @return 0 on success, -2 if the buffer is too small, other non-zero values on failure.
+ */
+int lcore_jose_sign_claims(
+    lcore_claims_t* claims,
+    const uint8_t* private_key,
+    size_t key_len,
+    size_t* jws_len
+);
+
 /**
  * @brief Verifies a JWS signature.
  *
@@ -58,6 +126,38 @@ int lcore_jose_verify(
     size_t* payload_len
 );
 
+/**
+ * @brief One JWS to check in a batch verification.
+ *
+ * Fields have the same meaning as the arguments of lcore_jose_verify().
+ */
+typedef struct {
+    const char* jws;
+    size_t jws_len;
+    const uint8_t* public_key;
+    size_t key_len;
+    uint8_t* payload_buffer;
+    size_t* payload_len;
+} lcore_jose_verify_item_t;
+
+/**
+ * @brief Verifies many JWS signatures in one call.
+ *
+ * Crypto initialization and public key import are shared across the batch:
+ * items signed by the same device key reuse one imported key. Each item is
+ * still verified on its own, so a bad signature only fails that item.
+ *
+ * @param[in] items The JWS tokens, keys and payload buffers to verify.
+ * @param[in] count The number of items.
+ * @param[out] results Optional array of @p count entries, set to 0 for each valid item and non-zero otherwise.
+ * @return 0 if every item is valid, non-zero if any item failed.
+ */
+int lcore_jose_verify_batch(
+    const lcore_jose_verify_item_t* items,
+    size_t count,
+    int* results
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,151 @@
+#ifndef LCORE_JOSE_ASYNC_H
+#define LCORE_JOSE_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <lcore/jose.h>
+
+/**
+ * @brief Opaque structure representing an asynchronous JOSE queue.
+ *
+ * Sign and verify requests are run on an internal worker thread. Completed
+ * requests are collected in a completion queue whose file descriptor can be
+ * added to an epoll/poll loop; callbacks run on the thread that calls
+ * lcore_jose_async_poll().
+ *
+ * The PSA key store in the pinned MbedTLS release is not safe for concurrent
+ * use, so workers share one SDK-wide lock with the synchronous lcore_jose_*
+ * and lcore_key_* calls: a synchronous call made from the event loop waits
+ * for the request currently running, if any.
+ */
+typedef struct lcore_jose_async lcore_jose_async_t;
+
+/**
+ * @brief Completion callback for an asynchronous request.
+ *
+ * @param[in] request_id The id returned when the request was submitted.
+ * @param[in] result The result lcore_jose_sign() or lcore_jose_verify() returned.
+ * @param[in] user_data The pointer passed at submission.
+ */
+typedef void (*lcore_jose_async_cb_t)(uint64_t request_id, int result, void* user_data);
+
+/**
+ * @brief Creates an asynchronous JOSE queue and starts its worker.
+ *
+ * @param[in] max_pending The maximum number of submitted requests not yet delivered through lcore_jose_async_poll().
+ * @return A pointer to the new queue, or NULL on failure.
+ */
+lcore_jose_async_t* lcore_jose_async_create(size_t max_pending);
+
+/**
+ * @brief Stops the worker and frees the queue.
+ *
+ * Requests that have not completed are dropped without invoking their callbacks.
+ * It may be called from a completion callback: no further callbacks run, later
+ * submissions fail, and the queue is released when lcore_jose_async_poll() returns.
+ *
+ * @param[in] queue The queue to free.
+ */
+void lcore_jose_async_free(lcore_jose_async_t* queue);
+
+/**
+ * @brief Queues a lcore_jose_sign() call.
+ *
+ * All buffers must stay valid until the callback runs or the request is cancelled.
+ *
+ * @param[in] queue The queue to submit to.
+ * @param[in] payload The data to sign.
+ * @param[in] payload_len The length of the data.
+ * @param[in] private_key The private key to sign with.
+ * @param[in] key_len The length of the private key.
+ * @param[in] alg The signing algorithm to use.
+ * @param[out] buffer The buffer to write the JWS to.
+ * @param[in,out] buffer_len The size of the buffer, updated with the actual size.
+ * @param[in] callback The function to invoke on completion.
+ * @param[in] user_data Pointer passed to the callback.
+ * @param[out] request_id Optional, set to the id of the queued request.
+ * @return 0 on success, -3 if max_pending requests are outstanding, other non-zero values on failure.
+ */
+int lcore_jose_async_sign(
+    lcore_jose_async_t* queue,
+    const uint8_t* payload,
+    size_t payload_len,
+    const uint8_t* private_key,
+    size_t key_len,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t* buffer_len,
+    lcore_jose_async_cb_t callback,
+    void* user_data,
+    uint64_t* request_id
+);
+
+/**
+ * @brief Queues a lcore_jose_verify() call.
+ *
+ * All buffers must stay valid until the callback runs or the request is cancelled.
+ *
+ * @param[in] queue The queue to submit to.
+ * @param[in] jws The JWS string to verify.
+ * @param[in] jws_len The length of the JWS string.
+ * @param[in] public_key The public key to verify with.
+ * @param[in] key_len The length of the public key.
+ * @param[out] payload_buffer Buffer to store the extracted payload.
+ * @param[in,out] payload_len The size of the payload buffer, updated with the actual size.
+ * @param[in] callback The function to invoke on completion.
+ * @param[in] user_data Pointer passed to the callback.
+ * @param[out] request_id Optional, set to the id of the queued request.
+ * @return 0 on success, -3 if max_pending requests are outstanding, other non-zero values on failure.
+ */
+int lcore_jose_async_verify(
+    lcore_jose_async_t* queue,
+    const char* jws,
+    size_t jws_len,
+    const uint8_t* public_key,
+    size_t key_len,
+    uint8_t* payload_buffer,
+    size_t* payload_len,
+    lcore_jose_async_cb_t callback,
+    void* user_data,
+    uint64_t* request_id
+);
+
+/**
+ * @brief Cancels a request that has not started yet.
+ *
+ * A cancelled request never invokes its callback.
+ *
+ * @param[in] queue The queue the request was submitted to.
+ * @param[in] request_id The id of the request to cancel.
+ * @return 0 if the request was cancelled, non-zero if it is running, completed or unknown.
+ */
+int lcore_jose_async_cancel(lcore_jose_async_t* queue, uint64_t request_id);
+
+/**
+ * @brief Returns a file descriptor that becomes readable when completions are ready.
+ *
+ * The descriptor is owned by the queue and must not be read or closed by the caller.
+ *
+ * @param[in] queue The queue to watch.
+ * @return The file descriptor, or -1 on failure.
+ */
+int lcore_jose_async_fd(const lcore_jose_async_t* queue);
+
+/**
+ * @brief Delivers completed requests by invoking their callbacks on the calling thread.
+ *
+ * @param[in] queue The queue to drain.
+ * @param[in] max_completions The maximum number of callbacks to invoke, 0 for no limit.
+ * @return The number of callbacks invoked.
+ */
+size_t lcore_jose_async_poll(lcore_jose_async_t* queue, size_t max_completions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LCORE_JOSE_ASYNC_H
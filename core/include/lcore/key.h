@@ -0,0 +1,71 @@
+#ifndef LCORE_KEY_H
+#define LCORE_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <lcore/did.h>
+
+/**
+ * @brief Identifier of a device key held in PSA persistent key storage.
+ *
+ * Must be in the PSA user range (1 to 0x3fffffff). On Linux the key is
+ * stored by the MbedTLS file-backed ITS in the working directory.
+ */
+typedef uint32_t lcore_key_id_t;
+
+/**
+ * @brief Stores a P-256 private key in persistent storage under the given id.
+ *
+ * This is done once, at provisioning time. Afterwards the key is used by id
+ * and its bytes need not stay in application memory.
+ *
+ * @param[in] key_id The id to store the key under.
+ * @param[in] private_key The private key.
+ * @param[in] key_len The length of the private key.
+ * @return 0 on success, -3 if a key already exists under this id, other non-zero values on failure.
+ */
+int lcore_key_provision(lcore_key_id_t key_id, const uint8_t* private_key, size_t key_len);
+
+/**
+ * @brief Checks whether a key is present in persistent storage.
+ *
+ * @param[in] key_id The id to look up.
+ * @return 1 if the key exists, 0 otherwise.
+ */
+int lcore_key_is_provisioned(lcore_key_id_t key_id);
+
+/**
+ * @brief Exports the public key of a stored key pair.
+ *
+ * @param[in] key_id The id of the key.
+ * @param[out] buffer The buffer to write the uncompressed public key to (65 bytes for P-256).
+ * @param[in,out] len The size of the buffer, updated with the actual size.
+ * @return 0 on success, non-zero on failure.
+ */
+int lcore_key_export_public(lcore_key_id_t key_id, uint8_t* buffer, size_t* len);
+
+/**
+ * @brief Creates the device DID from the public key of a stored key pair.
+ *
+ * @param[in] key_id The id of the key.
+ * @return A pointer to the new DID document, or NULL on failure.
+ */
+lcore_did_document_t* lcore_key_did_create(lcore_key_id_t key_id);
+
+/**
+ * @brief Removes a key from persistent storage.
+ *
+ * @param[in] key_id The id of the key.
+ * @return 0 on success, non-zero on failure.
+ */
+int lcore_key_destroy(lcore_key_id_t key_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LCORE_KEY_H
@@ -0,0 +1,295 @@
+#include <lcore/claims.h>
+#include "jose/base64url.h"
+#include <math.h>
+#include <string.h>
+
+static const uint64_t pow10_table[10] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL,
+    100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+// Largest scaled magnitude accepted by lcore_claims_add_double (below 2^63)
+#define CLAIMS_MAX_SCALED 9.0e18
+
+static void claims_reset(lcore_claims_t* claims, char* buffer, size_t size, int base64url) {
+    memset(claims, 0, sizeof(*claims));
+    claims->buffer = buffer;
+    claims->size = size;
+    claims->base64url = base64url;
+    if (!buffer || size == 0) {
+        claims->error = -1;
+    }
+}
+
+void lcore_claims_init(lcore_claims_t* claims, char* buffer, size_t size) {
+    if (claims) {
+        claims_reset(claims, buffer, size, 0);
+    }
+}
+
+void lcore_claims_init_b64url(lcore_claims_t* claims, char* buffer, size_t size) {
+    if (claims) {
+        claims_reset(claims, buffer, size, 1);
+    }
+}
+
+// Appends raw JSON text, encoding it on the fly in Base64URL mode.
+// One byte of the buffer is always kept for the terminator.
+static void emit(lcore_claims_t* claims, const char* data, size_t n) {
+    if (claims->error) {
+        return;
+    }
+
+    if (!claims->base64url) {
+        if (claims->len + n >= claims->size) {
+            claims->error = -2;
+            return;
+        }
+        memcpy(claims->buffer + claims->len, data, n);
+        claims->len += n;
+        return;
+    }
+
+    const uint8_t* in = (const uint8_t*)data;
+
+    // Complete a pending group first
+    if (claims->carry_len > 0) {
+        while (claims->carry_len < 3 && n > 0) {
+            claims->carry[claims->carry_len++] = *in++;
+            n--;
+        }
+        if (claims->carry_len < 3) {
+            return;
+        }
+        if (lcore_b64url_encode(claims->carry, 3, claims->buffer + claims->len, claims->size - claims->len) != 0) {
+            claims->error = -2;
+            return;
+        }
+        claims->len += 4;
+        claims->carry_len = 0;
+    }
+
+    // Encode whole groups straight into the buffer, keep the remainder
+    size_t whole = n - (n % 3);
+    if (whole > 0) {
+        if (lcore_b64url_encode(in, whole, claims->buffer + claims->len, claims->size - claims->len) != 0) {
+            claims->error = -2;
+            return;
+        }
+        claims->len += (whole / 3) * 4;
+    }
+    memcpy(claims->carry, in + whole, n - whole);
+    claims->carry_len = n - whole;
+}
+
+static void emit_char(lcore_claims_t* claims, char c) {
+    emit(claims, &c, 1);
+}
+
+// Writes a JSON string literal, escaping quotes, backslashes and control characters
+static void emit_string(lcore_claims_t* claims, const char* s) {
+    static const char hex[] = "0123456789abcdef";
+
+    emit_char(claims, '"');
+    const char* run = s;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        emit(claims, run, (size_t)(s - run));
+        run = s + 1;
+
+        char esc[6] = { '\\', (char)c, 0, 0, 0, 0 };
+        size_t esc_len = 2;
+        switch (c) {
+            case '"':
+            case '\\':
+                break;
+            case '\b': esc[1] = 'b'; break;
+            case '\f': esc[1] = 'f'; break;
+            case '\n': esc[1] = 'n'; break;
+            case '\r': esc[1] = 'r'; break;
+            case '\t': esc[1] = 't'; break;
+            default:
+                esc[1] = 'u';
+                esc[2] = '0';
+                esc[3] = '0';
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 0x0f];
+                esc_len = 6;
+                break;
+        }
+        emit(claims, esc, esc_len);
+    }
+    emit(claims, run, (size_t)(s - run));
+    emit_char(claims, '"');
+}
+
+// Writes the separator and "name": for the next field
+static int begin_field(lcore_claims_t* claims, const char* name) {
+    if (!name) {
+        if (!claims->error) {
+            claims->error = -1;
+        }
+        return -1;
+    }
+
+    emit_char(claims, claims->count == 0 ? '{' : ',');
+    emit_string(claims, name);
+    emit_char(claims, ':');
+    claims->count++;
+    return claims->error;
+}
+
+// Formats v in decimal, zero-padded to min_digits; returns the digit count
+static size_t format_uint(char* out, uint64_t v, size_t min_digits) {
+    char tmp[20];
+    size_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v > 0);
+    while (n < min_digits) {
+        tmp[n++] = '0';
+    }
+    for (size_t i = 0; i < n; i++) {
+        out[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+int lcore_claims_add_int(lcore_claims_t* claims, const char* name, int64_t value) {
+    if (!claims || claims->finished) {
+        return -1;
+    }
+    if (begin_field(claims, name) != 0) {
+        return claims->error;
+    }
+
+    char digits[21];
+    size_t n = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        digits[n++] = '-';
+        magnitude = 0 - magnitude;
+    }
+    n += format_uint(digits + n, magnitude, 1);
+    emit(claims, digits, n);
+    return claims->error;
+}
+
+int lcore_claims_add_double(lcore_claims_t* claims, const char* name, double value, unsigned decimals) {
+    if (!claims || claims->finished) {
+        return -1;
+    }
+    if (!isfinite(value) || decimals > 9 || fabs(value) * (double)pow10_table[decimals] >= CLAIMS_MAX_SCALED) {
+        if (!claims->error) {
+            claims->error = -1;
+        }
+        return -1;
+    }
+    if (begin_field(claims, name) != 0) {
+        return claims->error;
+    }
+
+    // Round to the requested resolution with integer arithmetic
+    double scaled = fabs(value) * (double)pow10_table[decimals] + 0.5;
+    uint64_t fixed = (uint64_t)scaled;
+    uint64_t int_part = fixed / pow10_table[decimals];
+    uint64_t frac_part = fixed % pow10_table[decimals];
+
+    // Drop trailing zeros of the fraction
+    while (decimals > 0 && frac_part % 10 == 0) {
+        frac_part /= 10;
+        decimals--;
+    }
+
+    char digits[32];
+    size_t n = 0;
+    if (value < 0 && fixed > 0) {
+        digits[n++] = '-';
+    }
+    n += format_uint(digits + n, int_part, 1);
+    if (decimals > 0) {
+        digits[n++] = '.';
+        n += format_uint(digits + n, frac_part, decimals);
+    }
+    emit(claims, digits, n);
+    return claims->error;
+}
+
+int lcore_claims_add_string(lcore_claims_t* claims, const char* name, const char* value) {
+    if (!claims || claims->finished) {
+        return -1;
+    }
+    if (!value) {
+        if (!claims->error) {
+            claims->error = -1;
+        }
+        return -1;
+    }
+    if (begin_field(claims, name) != 0) {
+        return claims->error;
+    }
+
+    emit_string(claims, value);
+    return claims->error;
+}
+
+int lcore_claims_add_bool(lcore_claims_t* claims, const char* name, int value) {
+    if (!claims || claims->finished) {
+        return -1;
+    }
+    if (begin_field(claims, name) != 0) {
+        return claims->error;
+    }
+
+    if (value) {
+        emit(claims, "true", 4);
+    } else {
+        emit(claims, "false", 5);
+    }
+    return claims->error;
+}
+
+int lcore_claims_finish(lcore_claims_t* claims, size_t* len) {
+    if (!claims) {
+        return -1;
+    }
+
+    // The object is closed once; later calls report the same outcome
+    if (claims->finished) {
+        if (!claims->error && len) {
+            *len = claims->len;
+        }
+        return claims->error;
+    }
+    claims->finished = 1;
+
+    if (claims->count == 0) {
+        emit_char(claims, '{');
+    }
+    emit_char(claims, '}');
+
+    // Flush the last partial group without padding
+    if (!claims->error && claims->base64url && claims->carry_len > 0) {
+        if (lcore_b64url_encode(claims->carry, claims->carry_len,
+                                claims->buffer + claims->len, claims->size - claims->len) != 0) {
+            claims->error = -2;
+        } else {
+            claims->len += lcore_b64url_encoded_len(claims->carry_len);
+            claims->carry_len = 0;
+        }
+    }
+    if (claims->error) {
+        return claims->error;
+    }
+
+    claims->buffer[claims->len] = '\0';
+    if (len) {
+        *len = claims->len;
+    }
+    return 0;
+}
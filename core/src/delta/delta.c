@@ -0,0 +1,539 @@
+#include <lcore/delta.h>
+#include <lcore/claims.h>
+#include <string.h>
+
+// Frame layout:
+//   byte 0      FRAME_MAGIC | flags (FRAME_KEYFRAME)
+//   byte 1      sequence number
+//   keyframe    varint field count, then per field:
+//               type << 4 | decimals, varint name length, name, value
+//   delta       per field in keyframe order: value change
+// Numbers are zigzag varints of the value scaled by 10^decimals (absolute in
+// keyframes, difference in deltas). Booleans are one byte. Strings are a
+// varint length and bytes; in deltas a length of 0 means unchanged and n + 1
+// means a new string of n bytes.
+
+#define FRAME_MAGIC 0xd0
+#define FRAME_MAGIC_MASK 0xf0
+#define FRAME_KEYFRAME 0x01
+
+#define FIELD_NUMBER 1
+#define FIELD_STRING 2
+#define FIELD_BOOL 3
+
+#define DELTA_MAX_DECIMALS 9
+#define DELTA_MAX_DIGITS 15
+#define DELTA_MAX_MAGNITUDE 1000000000000000LL // 10^15, exact in a double
+
+static const int64_t pow10_table[DELTA_MAX_DECIMALS + 1] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL,
+    100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL
+};
+
+void lcore_delta_init(lcore_delta_ctx_t* ctx, unsigned keyframe_interval) {
+    if (ctx) {
+        memset(ctx, 0, sizeof(*ctx));
+        ctx->keyframe_interval = keyframe_interval;
+    }
+}
+
+void lcore_delta_reset(lcore_delta_ctx_t* ctx) {
+    if (ctx) {
+        ctx->primed = 0;
+    }
+}
+
+// --- JSON subset parser ---
+
+typedef struct {
+    const char* p;
+    const char* end;
+} cursor_t;
+
+static void skip_ws(cursor_t* c) {
+    while (c->p < c->end && (*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r')) {
+        c->p++;
+    }
+}
+
+static int expect(cursor_t* c, char ch) {
+    skip_ws(c);
+    if (c->p >= c->end || *c->p != ch) {
+        return -1;
+    }
+    c->p++;
+    return 0;
+}
+
+// Reads a string literal without escapes into out
+static int parse_string(cursor_t* c, char* out, size_t out_size) {
+    if (expect(c, '"') != 0) {
+        return -1;
+    }
+    size_t n = 0;
+    while (c->p < c->end && *c->p != '"') {
+        unsigned char ch = (unsigned char)*c->p;
+        if (ch == '\\' || ch < 0x20 || n + 1 >= out_size) {
+            return -1;
+        }
+        out[n++] = (char)ch;
+        c->p++;
+    }
+    if (c->p >= c->end) {
+        return -1;
+    }
+    c->p++;
+    out[n] = '\0';
+    return 0;
+}
+
+// Reads a decimal number without exponent as value / 10^decimals
+static int parse_number(cursor_t* c, int64_t* value, uint8_t* decimals) {
+    int negative = 0;
+    if (c->p < c->end && *c->p == '-') {
+        negative = 1;
+        c->p++;
+    }
+
+    int64_t v = 0;
+    size_t digits = 0;
+    size_t int_digits = 0;
+    uint8_t frac_digits = 0;
+    int seen_point = 0;
+    for (; c->p < c->end; c->p++) {
+        char ch = *c->p;
+        if (ch >= '0' && ch <= '9') {
+            if (++digits > DELTA_MAX_DIGITS) {
+                return -1;
+            }
+            v = v * 10 + (ch - '0');
+            if (seen_point) {
+                frac_digits++;
+            } else {
+                int_digits++;
+            }
+        } else if (ch == '.' && !seen_point) {
+            seen_point = 1;
+        } else {
+            break;
+        }
+    }
+
+    if (int_digits == 0 || (seen_point && frac_digits == 0) || frac_digits > DELTA_MAX_DECIMALS) {
+        return -1;
+    }
+    if (c->p < c->end && (*c->p == 'e' || *c->p == 'E')) {
+        return -1;
+    }
+
+    *value = negative ? -v : v;
+    *decimals = frac_digits;
+    return 0;
+}
+
+static int parse_literal(cursor_t* c, const char* word) {
+    size_t n = strlen(word);
+    if ((size_t)(c->end - c->p) < n || memcmp(c->p, word, n) != 0) {
+        return -1;
+    }
+    c->p += n;
+    return 0;
+}
+
+// Parses a flat JSON object into fields
+static int parse_reading(const char* json, size_t json_len, lcore_delta_field_t* fields, size_t* count) {
+    cursor_t c = { json, json + json_len };
+    size_t n = 0;
+
+    if (expect(&c, '{') != 0) {
+        return -1;
+    }
+    skip_ws(&c);
+    if (c.p < c.end && *c.p == '}') {
+        c.p++;
+    } else {
+        for (;;) {
+            if (n >= LCORE_DELTA_MAX_FIELDS) {
+                return -1;
+            }
+            lcore_delta_field_t* field = &fields[n];
+            memset(field, 0, sizeof(*field));
+            if (parse_string(&c, field->name, sizeof(field->name)) != 0 || expect(&c, ':') != 0) {
+                return -1;
+            }
+
+            skip_ws(&c);
+            if (c.p >= c.end) {
+                return -1;
+            }
+            if (*c.p == '"') {
+                field->type = FIELD_STRING;
+                if (parse_string(&c, field->text, sizeof(field->text)) != 0) {
+                    return -1;
+                }
+            } else if (*c.p == 't' || *c.p == 'f') {
+                field->type = FIELD_BOOL;
+                field->value = (*c.p == 't');
+                if (parse_literal(&c, field->value ? "true" : "false") != 0) {
+                    return -1;
+                }
+            } else {
+                field->type = FIELD_NUMBER;
+                if (parse_number(&c, &field->value, &field->decimals) != 0) {
+                    return -1;
+                }
+            }
+            n++;
+
+            skip_ws(&c);
+            if (c.p < c.end && *c.p == ',') {
+                c.p++;
+                continue;
+            }
+            if (expect(&c, '}') != 0) {
+                return -1;
+            }
+            break;
+        }
+    }
+
+    skip_ws(&c);
+    if (c.p != c.end) {
+        return -1;
+    }
+    *count = n;
+    return 0;
+}
+
+// --- Frame writer / reader ---
+
+typedef struct {
+    uint8_t* buf;
+    size_t size;
+    size_t len;
+    int error;
+} frame_writer_t;
+
+static void put_byte(frame_writer_t* w, uint8_t b) {
+    if (w->len >= w->size) {
+        w->error = -2;
+        return;
+    }
+    w->buf[w->len++] = b;
+}
+
+static void put_varint(frame_writer_t* w, uint64_t v) {
+    do {
+        uint8_t b = v & 0x7f;
+        v >>= 7;
+        put_byte(w, v ? (b | 0x80) : b);
+    } while (v && !w->error);
+}
+
+static void put_signed(frame_writer_t* w, int64_t v) {
+    put_varint(w, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static void put_bytes(frame_writer_t* w, const char* data, size_t n) {
+    if (w->size - w->len < n) {
+        w->error = -2;
+        return;
+    }
+    memcpy(w->buf + w->len, data, n);
+    w->len += n;
+}
+
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+} frame_reader_t;
+
+static int get_byte(frame_reader_t* r, uint8_t* b) {
+    if (r->p >= r->end) {
+        return -1;
+    }
+    *b = *r->p++;
+    return 0;
+}
+
+static int get_varint(frame_reader_t* r, uint64_t* v) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint8_t b;
+        if (get_byte(r, &b) != 0) {
+            return -1;
+        }
+        result |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            *v = result;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int get_signed(frame_reader_t* r, int64_t* v) {
+    uint64_t u;
+    if (get_varint(r, &u) != 0) {
+        return -1;
+    }
+    *v = (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+    return 0;
+}
+
+static int get_text(frame_reader_t* r, size_t n, char* out, size_t out_size) {
+    if (n >= out_size || (size_t)(r->end - r->p) < n) {
+        return -1;
+    }
+    memcpy(out, r->p, n);
+    out[n] = '\0';
+    r->p += n;
+    return 0;
+}
+
+static int out_of_range(int64_t v, int64_t limit) {
+    return v >= limit || v <= -limit;
+}
+
+// Rescales the parsed reading to the remembered field layout.
+// Returns 0 if a delta frame can be sent.
+static int match_schema(const lcore_delta_ctx_t* ctx, lcore_delta_field_t* fields, size_t count) {
+    if (!ctx->primed || count != ctx->field_count) {
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const lcore_delta_field_t* prev = &ctx->fields[i];
+        lcore_delta_field_t* cur = &fields[i];
+        if (cur->type != prev->type || strcmp(cur->name, prev->name) != 0) {
+            return -1;
+        }
+        if (cur->type == FIELD_NUMBER) {
+            if (cur->decimals > prev->decimals) {
+                return -1;
+            }
+            int64_t scale = pow10_table[prev->decimals - cur->decimals];
+            if (out_of_range(cur->value, DELTA_MAX_MAGNITUDE / scale)) {
+                return -1;
+            }
+            cur->value *= scale;
+            cur->decimals = prev->decimals;
+        }
+    }
+    return 0;
+}
+
+int lcore_delta_encode(
+    lcore_delta_ctx_t* ctx,
+    const char* json,
+    size_t json_len,
+    uint8_t* frame,
+    size_t* frame_len
+) {
+    if (!ctx || !json || !frame || !frame_len) {
+        return -1;
+    }
+
+    lcore_delta_field_t fields[LCORE_DELTA_MAX_FIELDS];
+    size_t count = 0;
+    if (parse_reading(json, json_len, fields, &count) != 0) {
+        return -1;
+    }
+
+    int keyframe = (ctx->keyframe_interval > 0 && ctx->since_keyframe + 1 >= ctx->keyframe_interval);
+    if (!keyframe && match_schema(ctx, fields, count) != 0) {
+        keyframe = 1;
+    }
+
+    frame_writer_t w = { frame, *frame_len, 0, 0 };
+    uint8_t sequence = (uint8_t)(ctx->sequence + 1);
+    put_byte(&w, FRAME_MAGIC | (keyframe ? FRAME_KEYFRAME : 0));
+    put_byte(&w, sequence);
+
+    if (keyframe) {
+        put_varint(&w, count);
+        for (size_t i = 0; i < count; i++) {
+            const lcore_delta_field_t* field = &fields[i];
+            size_t name_len = strlen(field->name);
+            put_byte(&w, (uint8_t)((field->type << 4) | field->decimals));
+            put_varint(&w, name_len);
+            put_bytes(&w, field->name, name_len);
+            if (field->type == FIELD_NUMBER) {
+                put_signed(&w, field->value);
+            } else if (field->type == FIELD_BOOL) {
+                put_byte(&w, (uint8_t)field->value);
+            } else {
+                size_t text_len = strlen(field->text);
+                put_varint(&w, text_len);
+                put_bytes(&w, field->text, text_len);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            const lcore_delta_field_t* field = &fields[i];
+            const lcore_delta_field_t* prev = &ctx->fields[i];
+            if (field->type == FIELD_NUMBER) {
+                put_signed(&w, field->value - prev->value);
+            } else if (field->type == FIELD_BOOL) {
+                put_byte(&w, (uint8_t)field->value);
+            } else if (strcmp(field->text, prev->text) == 0) {
+                put_varint(&w, 0);
+            } else {
+                size_t text_len = strlen(field->text);
+                put_varint(&w, text_len + 1);
+                put_bytes(&w, field->text, text_len);
+            }
+        }
+    }
+
+    if (w.error) {
+        return w.error;
+    }
+
+    // Commit the new reading only once the frame is complete
+    memcpy(ctx->fields, fields, count * sizeof(lcore_delta_field_t));
+    ctx->field_count = count;
+    ctx->sequence = sequence;
+    ctx->primed = 1;
+    ctx->since_keyframe = keyframe ? 0 : ctx->since_keyframe + 1;
+
+    *frame_len = w.len;
+    return 0;
+}
+
+static int write_json(const lcore_delta_field_t* fields, size_t count, char* json, size_t* json_len) {
+    lcore_claims_t claims;
+    lcore_claims_init(&claims, json, *json_len);
+
+    for (size_t i = 0; i < count; i++) {
+        const lcore_delta_field_t* field = &fields[i];
+        if (field->type == FIELD_STRING) {
+            lcore_claims_add_string(&claims, field->name, field->text);
+        } else if (field->type == FIELD_BOOL) {
+            lcore_claims_add_bool(&claims, field->name, (int)field->value);
+        } else if (field->decimals == 0) {
+            lcore_claims_add_int(&claims, field->name, field->value);
+        } else {
+            lcore_claims_add_double(&claims, field->name,
+                                    (double)field->value / (double)pow10_table[field->decimals],
+                                    field->decimals);
+        }
+    }
+
+    return lcore_claims_finish(&claims, json_len);
+}
+
+int lcore_delta_decode(
+    lcore_delta_ctx_t* ctx,
+    const uint8_t* frame,
+    size_t frame_len,
+    char* json,
+    size_t* json_len
+) {
+    if (!ctx || !frame || !json || !json_len) {
+        return -1;
+    }
+
+    frame_reader_t r = { frame, frame + frame_len };
+    uint8_t flags, sequence;
+    if (get_byte(&r, &flags) != 0 || get_byte(&r, &sequence) != 0 ||
+        (flags & FRAME_MAGIC_MASK) != FRAME_MAGIC) {
+        return -1;
+    }
+
+    lcore_delta_field_t fields[LCORE_DELTA_MAX_FIELDS];
+    size_t count;
+
+    if (flags & FRAME_KEYFRAME) {
+        uint64_t n;
+        if (get_varint(&r, &n) != 0 || n > LCORE_DELTA_MAX_FIELDS) {
+            return -1;
+        }
+        count = (size_t)n;
+        for (size_t i = 0; i < count; i++) {
+            lcore_delta_field_t* field = &fields[i];
+            memset(field, 0, sizeof(*field));
+            uint8_t layout;
+            uint64_t len;
+            if (get_byte(&r, &layout) != 0 || get_varint(&r, &len) != 0 ||
+                get_text(&r, (size_t)len, field->name, sizeof(field->name)) != 0) {
+                return -1;
+            }
+            field->type = layout >> 4;
+            field->decimals = layout & 0x0f;
+            if (field->decimals > DELTA_MAX_DECIMALS) {
+                return -1;
+            }
+
+            if (field->type == FIELD_NUMBER) {
+                if (get_signed(&r, &field->value) != 0) {
+                    return -1;
+                }
+            } else if (field->type == FIELD_BOOL) {
+                uint8_t b;
+                if (get_byte(&r, &b) != 0) {
+                    return -1;
+                }
+                field->value = (b != 0);
+            } else if (field->type == FIELD_STRING) {
+                if (get_varint(&r, &len) != 0 ||
+                    get_text(&r, (size_t)len, field->text, sizeof(field->text)) != 0) {
+                    return -1;
+                }
+            } else {
+                return -1;
+            }
+        }
+    } else {
+        if (!ctx->primed || sequence != (uint8_t)(ctx->sequence + 1)) {
+            return -3; // Lost frame: a keyframe is needed
+        }
+        count = ctx->field_count;
+        memcpy(fields, ctx->fields, count * sizeof(lcore_delta_field_t));
+        for (size_t i = 0; i < count; i++) {
+            lcore_delta_field_t* field = &fields[i];
+            if (field->type == FIELD_NUMBER) {
+                int64_t diff;
+                if (get_signed(&r, &diff) != 0) {
+                    return -1;
+                }
+                field->value = (int64_t)((uint64_t)field->value + (uint64_t)diff);
+            } else if (field->type == FIELD_BOOL) {
+                uint8_t b;
+                if (get_byte(&r, &b) != 0) {
+                    return -1;
+                }
+                field->value = (b != 0);
+            } else {
+                uint64_t len;
+                if (get_varint(&r, &len) != 0) {
+                    return -1;
+                }
+                if (len > 0 && get_text(&r, (size_t)(len - 1), field->text, sizeof(field->text)) != 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    if (r.p != r.end) {
+        return -1;
+    }
+
+    // Reject values the JSON writer cannot reproduce exactly
+    for (size_t i = 0; i < count; i++) {
+        if (fields[i].type == FIELD_NUMBER && out_of_range(fields[i].value, DELTA_MAX_MAGNITUDE)) {
+            return -1;
+        }
+    }
+
+    int result = write_json(fields, count, json, json_len);
+    if (result != 0) {
+        return result;
+    }
+
+    memcpy(ctx->fields, fields, count * sizeof(lcore_delta_field_t));
+    ctx->field_count = count;
+    ctx->sequence = sequence;
+    ctx->primed = 1;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "base64url.h"
+
+static const char base64url_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+size_t lcore_b64url_encoded_len(size_t input_len) {
+    return (input_len / 3) * 4 + ((input_len % 3) ? (input_len % 3) + 1 : 0);
+}
+
+// Encodes directly into the URL-safe alphabet, so no translation pass is needed
+int lcore_b64url_encode(const uint8_t* input, size_t input_len, char* output, size_t output_size) {
+    size_t olen = lcore_b64url_encoded_len(input_len);
+    if (output_size < olen + 1) {
+        return -1;
+    }
+    
+    size_t i = 0;
+    char* out = output;
+    for (; i + 3 <= input_len; i += 3) {
+        uint32_t v = ((uint32_t)input[i] << 16) | ((uint32_t)input[i + 1] << 8) | input[i + 2];
+        *out++ = base64url_alphabet[(v >> 18) & 0x3f];
+        *out++ = base64url_alphabet[(v >> 12) & 0x3f];
+        *out++ = base64url_alphabet[(v >> 6) & 0x3f];
+        *out++ = base64url_alphabet[v & 0x3f];
+    }
+    
+    // Tail without padding
+    size_t rest = input_len - i;
+    if (rest > 0) {
+        uint32_t v = (uint32_t)input[i] << 16;
+        if (rest == 2) {
+            v |= (uint32_t)input[i + 1] << 8;
+        }
+        *out++ = base64url_alphabet[(v >> 18) & 0x3f];
+        *out++ = base64url_alphabet[(v >> 12) & 0x3f];
+        if (rest == 2) {
+            *out++ = base64url_alphabet[(v >> 6) & 0x3f];
+        }
+    }
+    
+    *out = '\0';
+    return 0;
+}
+
+// Maps a character of the URL-safe alphabet to its 6-bit value, -1 for anything else
+static int base64url_value(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '-') return 62;
+    if (c == '_') return 63;
+    return -1;
+}
+
+int lcore_b64url_decoded_len(const char* input, size_t input_len, size_t* decoded_len) {
+    // A single trailing character cannot carry a whole byte
+    size_t rest = input_len % 4;
+    if (rest == 1) {
+        return -1;
+    }
+    
+    for (size_t i = 0; i < input_len; i++) {
+        if (base64url_value((unsigned char)input[i]) < 0) {
+            return -1;
+        }
+    }
+    
+    // The unused low bits of the last character must be zero, so each
+    // byte string has exactly one accepted encoding
+    if (rest > 0) {
+        int last = base64url_value((unsigned char)input[input_len - 1]);
+        if ((rest == 2 && (last & 0x0f) != 0) || (rest == 3 && (last & 0x03) != 0)) {
+            return -1;
+        }
+    }
+    
+    *decoded_len = (input_len / 4) * 3 + (rest ? rest - 1 : 0);
+    return 0;
+}
+
+int lcore_b64url_decode(const char* input, size_t input_len, uint8_t* output, size_t* output_len) {
+    size_t decoded_len;
+    if (lcore_b64url_decoded_len(input, input_len, &decoded_len) != 0 || decoded_len > *output_len) {
+        return -1;
+    }
+    
+    const unsigned char* in = (const unsigned char*)input;
+    uint8_t* out = output;
+    size_t i = 0;
+    for (; i + 4 <= input_len; i += 4) {
+        uint32_t v = ((uint32_t)base64url_value(in[i]) << 18) |
+                     ((uint32_t)base64url_value(in[i + 1]) << 12) |
+                     ((uint32_t)base64url_value(in[i + 2]) << 6) |
+                     (uint32_t)base64url_value(in[i + 3]);
+        *out++ = (uint8_t)(v >> 16);
+        *out++ = (uint8_t)(v >> 8);
+        *out++ = (uint8_t)v;
+    }
+    
+    // Tail of two or three characters
+    size_t rest = input_len - i;
+    if (rest > 0) {
+        uint32_t v = ((uint32_t)base64url_value(in[i]) << 18) |
+                     ((uint32_t)base64url_value(in[i + 1]) << 12);
+        if (rest == 3) {
+            v |= (uint32_t)base64url_value(in[i + 2]) << 6;
+        }
+        *out++ = (uint8_t)(v >> 16);
+        if (rest == 3) {
+            *out++ = (uint8_t)(v >> 8);
+        }
+    }
+    
+    *output_len = decoded_len;
+    return 0;
+}
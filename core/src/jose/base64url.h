@@ -0,0 +1,21 @@
+#ifndef LCORE_BASE64URL_H
+#define LCORE_BASE64URL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Length of the unpadded Base64URL encoding of input_len bytes (excluding terminator)
+size_t lcore_b64url_encoded_len(size_t input_len);
+
+// Base64URL encoding (without padding), NUL-terminated; output_size must cover the terminator
+int lcore_b64url_encode(const uint8_t* input, size_t input_len, char* output, size_t output_size);
+
+// Checks that input is canonical unpadded Base64URL (only [A-Za-z0-9_-], zero
+// trailing bits) and returns the decoded size without decoding
+int lcore_b64url_decoded_len(const char* input, size_t input_len, size_t* decoded_len);
+
+// Base64URL decoding of input_len characters; *output_len is the buffer size in, decoded size out.
+// Rejects anything lcore_b64url_decoded_len() rejects, including '+', '/' and '=' padding.
+int lcore_b64url_decode(const char* input, size_t input_len, uint8_t* output, size_t* output_len);
+
+#endif // LCORE_BASE64URL_H
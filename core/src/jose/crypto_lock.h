@@ -0,0 +1,11 @@
+#ifndef LCORE_CRYPTO_LOCK_H
+#define LCORE_CRYPTO_LOCK_H
+
+// Serializes PSA calls across threads. The MbedTLS 3.4 key store is not
+// thread-safe, so every public entry point that touches PSA (lcore_jose_*,
+// lcore_key_*, and the asynchronous queue's workers through them) holds
+// this lock for the duration of the call. Entry points never nest.
+void lcore_crypto_lock(void);
+void lcore_crypto_unlock(void);
+
+#endif // LCORE_CRYPTO_LOCK_H
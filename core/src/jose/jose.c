@@ -1,105 +1,178 @@
 #include <lcore/jose.h>
 #include <psa/crypto.h>
-#include <mbedtls/base64.h>
+#include "base64url.h"
+#include "jws.h"
+#include "crypto_lock.h"
+#include <pthread.h>
 #include <string.h>
 #include <stdlib.h>
 
 // ARM PSA approach (IoTeX pattern) - RISC-V compatible
 
-// Base64URL encoding helper (without padding)
-static int base64url_encode(const uint8_t* input, size_t input_len, char* output, size_t output_size) {
-    size_t olen = 0;
-    int ret = mbedtls_base64_encode((unsigned char*)output, output_size, &olen, input, input_len);
-    if (ret != 0) {
+static pthread_mutex_t crypto_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void lcore_crypto_lock(void) {
+    pthread_mutex_lock(&crypto_lock);
+}
+
+void lcore_crypto_unlock(void) {
+    pthread_mutex_unlock(&crypto_lock);
+}
+
+// Base64URL of the ES256 JWS header {"alg":"ES256","typ":"JWT"}
+#define JWS_HEADER_B64 "eyJhbGciOiJFUzI1NiIsInR5cCI6IkpXVCJ9"
+#define JWS_HEADER_B64_LEN (sizeof(JWS_HEADER_B64) - 1)
+
+// Base64URL length of a 64-byte P-256 signature
+#define JWS_SIGNATURE_B64_LEN 86
+
+// Smallest buffer for a claims JWS: header, "{}" payload, signature and terminator
+#define JWS_CLAIMS_MIN_LEN (JWS_HEADER_B64_LEN + 1 + 3 + 1 + JWS_SIGNATURE_B64_LEN + 1)
+
+// Locates the two '.' separators of a compact JWS (header.payload.signature).
+// Rejects empty segments and any extra separators.
+static int jws_split(const char* jws, size_t jws_len, size_t* header_end, size_t* payload_end) {
+    const char* dot1 = memchr(jws, '.', jws_len);
+    if (!dot1 || dot1 == jws) {
         return -1;
     }
     
-    // Convert to base64url (replace + with -, / with _, remove padding)
-    for (size_t i = 0; i < olen; i++) {
-        if (output[i] == '+') output[i] = '-';
-        else if (output[i] == '/') output[i] = '_';
-        else if (output[i] == '=') {
-            output[i] = '\0';
-            break;
-        }
+    size_t rest = jws_len - (size_t)(dot1 - jws) - 1;
+    const char* dot2 = memchr(dot1 + 1, '.', rest);
+    if (!dot2 || dot2 == dot1 + 1) {
+        return -1;
     }
     
+    rest = jws_len - (size_t)(dot2 - jws) - 1;
+    if (rest == 0 || memchr(dot2 + 1, '.', rest)) {
+        return -1;
+    }
+    
+    *header_end = (size_t)(dot1 - jws);
+    *payload_end = (size_t)(dot2 - jws);
     return 0;
 }
 
-// Base64URL decoding helper
-static int base64url_decode(const char* input, uint8_t* output, size_t* output_len) {
-    size_t input_len = strlen(input);
-    char* padded_input = malloc(input_len + 4); // Add space for padding
-    if (!padded_input) {
-        return -1;
-    }
+// Imports a P-256 public key as a volatile PSA verification key
+static int import_public_key(const uint8_t* public_key, size_t key_len, psa_key_id_t* key_id) {
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_VERIFY_MESSAGE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_PUBLIC_KEY(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attributes, 256); // P-256
     
-    strcpy(padded_input, input);
+    psa_status_t status = psa_import_key(&attributes, public_key, key_len, key_id);
+    psa_reset_key_attributes(&attributes);
     
-    // Convert base64url to base64
-    for (size_t i = 0; i < input_len; i++) {
-        if (padded_input[i] == '-') padded_input[i] = '+';
-        else if (padded_input[i] == '_') padded_input[i] = '/';
+    return (status == PSA_SUCCESS) ? 0 : -1;
+}
+
+int lcore_jws_parse(const char* jws, size_t jws_len, lcore_jws_parts_t* parts) {
+    if (jws_split(jws, jws_len, &parts->header_end, &parts->payload_end) != 0) {
+        return -1; // Invalid JWS format
     }
     
-    // Add padding if needed
-    size_t padding = (4 - (input_len % 4)) % 4;
-    for (size_t i = 0; i < padding; i++) {
-        strcat(padded_input, "=");
+    // The header is never decoded, so check its encoding here
+    size_t header_len;
+    if (lcore_b64url_decoded_len(jws, parts->header_end, &header_len) != 0) {
+        return -1;
     }
     
-    size_t decoded_len = *output_len;
-    int ret = mbedtls_base64_decode(output, *output_len, &decoded_len, 
-                                   (const unsigned char*)padded_input, strlen(padded_input));
-    
-    free(padded_input);
-    
-    if (ret != 0) {
+    // Decode signature
+    parts->signature_len = sizeof(parts->signature);
+    return lcore_b64url_decode(jws + parts->payload_end + 1, jws_len - parts->payload_end - 1,
+                               parts->signature, &parts->signature_len);
+}
+
+int lcore_jws_decode_payload(const char* jws, const lcore_jws_parts_t* parts, uint8_t* payload, size_t* payload_len) {
+    size_t decoded_len = *payload_len;
+    if (lcore_b64url_decode(jws + parts->header_end + 1, parts->payload_end - parts->header_end - 1,
+                            payload, &decoded_len) != 0) {
         return -1;
     }
-    
-    *output_len = decoded_len;
+    *payload_len = decoded_len;
     return 0;
 }
 
-int lcore_jose_sign(
-    const uint8_t* payload,
-    size_t payload_len,
-    const uint8_t* private_key,
-    size_t key_len,
-    lcore_jose_alg_t alg,
-    char* buffer,
-    size_t* buffer_len
+// Verifies a compact JWS against an already imported key and extracts the payload.
+// The signing input is the "header.payload" prefix of the token itself, so no copy is made.
+static int verify_with_key(
+    psa_key_id_t key_id,
+    const char* jws,
+    size_t jws_len,
+    uint8_t* payload_buffer,
+    size_t* payload_len
 ) {
-    if (!payload || !private_key || !buffer || !buffer_len) {
+    lcore_jws_parts_t parts;
+    if (lcore_jws_parse(jws, jws_len, &parts) != 0) {
         return -1;
     }
-
-    // Initialize PSA crypto (IoTeX pattern)
-    psa_status_t status = psa_crypto_init();
+    
+    // Verify signature using ARM PSA
+    psa_status_t status = psa_verify_message(
+        key_id,
+        PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+        (const uint8_t*)jws, parts.payload_end,
+        parts.signature, parts.signature_len
+    );
     if (status != PSA_SUCCESS) {
         return -1;
     }
+    
+    // Signature is valid, decode payload
+    return lcore_jws_decode_payload(jws, &parts, payload_buffer, payload_len);
+}
 
-    // Create JWS header for ES256
-    const char* header = "{\"alg\":\"ES256\",\"typ\":\"JWT\"}";
+// Signs the "header.payload" already in buffer with an imported key and
+// appends ".signature" after it. *buffer_len is the buffer size in, JWS length out.
+static int sign_with_key(psa_key_id_t key_id, char* buffer, size_t signing_input_len, size_t* buffer_len) {
+    size_t required = signing_input_len + 1 + JWS_SIGNATURE_B64_LEN + 1;
+    if (*buffer_len < required) {
+        *buffer_len = required;
+        return -2; // Buffer too small
+    }
+    
+    // Generate ECDSA signature using ARM PSA (IoTeX pattern)
+    uint8_t signature[64]; // P-256 signature is typically 64 bytes
+    size_t signature_length;
     
-    // Base64URL encode header
-    char header_b64[256];
-    if (base64url_encode((const uint8_t*)header, strlen(header), header_b64, sizeof(header_b64)) != 0) {
+    psa_status_t status = psa_sign_message(
+        key_id,
+        PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+        (const uint8_t*)buffer, signing_input_len,
+        signature, sizeof(signature), &signature_length
+    );
+    if (status != PSA_SUCCESS) {
         return -1;
     }
     
-    // Base64URL encode payload
-    char payload_b64[1024];
-    if (base64url_encode(payload, payload_len, payload_b64, sizeof(payload_b64)) != 0) {
+    // Append Base64URL signature: header.payload.signature
+    buffer[signing_input_len] = '.';
+    size_t sig_offset = signing_input_len + 1;
+    if (lcore_b64url_encode(signature, signature_length, buffer + sig_offset, *buffer_len - sig_offset) != 0) {
         return -1;
     }
+
+    *buffer_len = sig_offset + lcore_b64url_encoded_len(signature_length);
+    return 0;
+}
+
+// Imports a raw private key for one signature, then signs in place
+static int sign_with_raw_key(
+    const uint8_t* private_key,
+    size_t key_len,
+    char* buffer,
+    size_t signing_input_len,
+    size_t* buffer_len
+) {
+    lcore_crypto_lock();
     
-    // Create signing input: header.payload
-    char signing_input[2048];
-    snprintf(signing_input, sizeof(signing_input), "%s.%s", header_b64, payload_b64);
+    // Initialize PSA crypto (IoTeX pattern)
+    psa_status_t status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        lcore_crypto_unlock();
+        return -1;
+    }
     
     // Import private key for PSA (IoTeX pattern)
     psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
@@ -110,47 +183,156 @@ int lcore_jose_sign(
     
     psa_key_id_t key_id;
     status = psa_import_key(&attributes, private_key, key_len, &key_id);
+    psa_reset_key_attributes(&attributes);
     if (status != PSA_SUCCESS) {
-        psa_reset_key_attributes(&attributes);
+        lcore_crypto_unlock();
         return -1;
     }
     
-    // Generate ECDSA signature using ARM PSA (IoTeX pattern)
-    uint8_t signature[64]; // P-256 signature is typically 64 bytes
-    size_t signature_length;
-    
-    status = psa_sign_message(
-        key_id,
-        PSA_ALG_ECDSA(PSA_ALG_SHA_256),
-        (const uint8_t*)signing_input, strlen(signing_input),
-        signature, sizeof(signature), &signature_length
-    );
+    int result = sign_with_key(key_id, buffer, signing_input_len, buffer_len);
     
     // Clean up key
     psa_destroy_key(key_id);
-    psa_reset_key_attributes(&attributes);
     
-    if (status != PSA_SUCCESS) {
+    lcore_crypto_unlock();
+    return result;
+}
+
+// Writes "header.payload" into buffer, checking up front that the whole JWS fits
+static int write_signing_input(
+    const uint8_t* payload,
+    size_t payload_len,
+    char* buffer,
+    size_t* buffer_len,
+    size_t* signing_input_len
+) {
+    *signing_input_len = JWS_HEADER_B64_LEN + 1 + lcore_b64url_encoded_len(payload_len);
+    size_t required = *signing_input_len + 1 + JWS_SIGNATURE_B64_LEN + 1;
+    if (*buffer_len < required) {
+        *buffer_len = required;
+        return -2; // Buffer too small
+    }
+    
+    memcpy(buffer, JWS_HEADER_B64 ".", JWS_HEADER_B64_LEN + 1);
+    if (lcore_b64url_encode(payload, payload_len, buffer + JWS_HEADER_B64_LEN + 1,
+                            *buffer_len - JWS_HEADER_B64_LEN - 1) != 0) {
         return -1;
     }
     
-    // Base64URL encode signature
-    char sig_b64[128];
-    if (base64url_encode(signature, signature_length, sig_b64, sizeof(sig_b64)) != 0) {
+    return 0;
+}
+
+int lcore_jose_sign(
+    const uint8_t* payload,
+    size_t payload_len,
+    const uint8_t* private_key,
+    size_t key_len,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t* buffer_len
+) {
+    if (!payload || !private_key || !buffer || !buffer_len) {
         return -1;
     }
+
+    // The JWS is assembled in the caller's buffer: header.payload, then the signature
+    size_t signing_input_len;
+    int result = write_signing_input(payload, payload_len, buffer, buffer_len, &signing_input_len);
+    if (result != 0) {
+        return result;
+    }
     
-    // Create final JWS: header.payload.signature
-    int jws_len = snprintf(buffer, *buffer_len, "%s.%s.%s", header_b64, payload_b64, sig_b64);
-    if (jws_len >= (int)*buffer_len) {
-        *buffer_len = jws_len + 1;
-        return -2; // Buffer too small
+    return sign_with_raw_key(private_key, key_len, buffer, signing_input_len, buffer_len);
+}
+
+int lcore_jose_sign_with_key(
+    const uint8_t* payload,
+    size_t payload_len,
+    lcore_key_id_t key_id,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t* buffer_len
+) {
+    if (!payload || !buffer || !buffer_len) {
+        return -1;
     }
 
-    *buffer_len = jws_len;
+    size_t signing_input_len;
+    int result = write_signing_input(payload, payload_len, buffer, buffer_len, &signing_input_len);
+    if (result != 0) {
+        return result;
+    }
+    
+    lcore_crypto_lock();
+    
+    // Initialize PSA crypto; the persistent key is loaded from storage on first use
+    if (psa_crypto_init() != PSA_SUCCESS) {
+        result = -1;
+    } else {
+        result = sign_with_key(key_id, buffer, signing_input_len, buffer_len);
+    }
+    
+    lcore_crypto_unlock();
+    return result;
+}
+
+int lcore_jose_claims_init(
+    lcore_claims_t* claims,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t buffer_len
+) {
+    if (!claims || !buffer) {
+        return -1;
+    }
+    
+    lcore_claims_init_b64url(claims, buffer, buffer_len);
+    if (buffer_len <= JWS_HEADER_B64_LEN + 1) {
+        claims->error = -2;
+        return -2; // Buffer too small
+    }
+    
+    // Claims are encoded directly after the header
+    memcpy(buffer, JWS_HEADER_B64 ".", JWS_HEADER_B64_LEN + 1);
+    claims->len = JWS_HEADER_B64_LEN + 1;
     return 0;
 }
 
+int lcore_jose_sign_claims(
+    lcore_claims_t* claims,
+    const uint8_t* private_key,
+    size_t key_len,
+    size_t* jws_len
+) {
+    if (!claims || !private_key || !jws_len) {
+        return -1;
+    }
+    
+    // Only writers started by lcore_jose_claims_init hold a JWS header
+    if (!claims->base64url || !claims->buffer) {
+        return -1;
+    }
+    if (claims->size <= JWS_HEADER_B64_LEN + 1) {
+        if (claims->error != -2) {
+            return -1;
+        }
+        *jws_len = JWS_CLAIMS_MIN_LEN;
+        return -2; // Buffer too small for the header
+    }
+    if (memcmp(claims->buffer, JWS_HEADER_B64 ".", JWS_HEADER_B64_LEN + 1) != 0) {
+        return -1;
+    }
+    
+    size_t signing_input_len;
+    int result = lcore_claims_finish(claims, &signing_input_len);
+    if (result != 0) {
+        return result;
+    }
+    
+    *jws_len = claims->size;
+    return sign_with_raw_key(private_key, key_len, claims->buffer, signing_input_len, jws_len);
+}
+
 int lcore_jose_verify(
     const char* jws,
     size_t jws_len,
@@ -163,76 +345,136 @@ int lcore_jose_verify(
         return -1;
     }
 
+    lcore_crypto_lock();
+    
     // Initialize PSA crypto
     psa_status_t status = psa_crypto_init();
     if (status != PSA_SUCCESS) {
+        lcore_crypto_unlock();
         return -1;
     }
 
-    // Split JWS into header.payload.signature
-    char *jws_copy = strndup(jws, jws_len);
-    if (!jws_copy) {
+    // Import public key for PSA (IoTeX pattern)
+    psa_key_id_t key_id;
+    if (import_public_key(public_key, key_len, &key_id) != 0) {
+        lcore_crypto_unlock();
         return -1;
     }
     
-    char *header_b64 = strtok(jws_copy, ".");
-    char *payload_b64 = strtok(NULL, ".");
-    char *sig_b64 = strtok(NULL, ".");
+    int result = verify_with_key(key_id, jws, jws_len, payload_buffer, payload_len);
     
-    if (!header_b64 || !payload_b64 || !sig_b64) {
-        free(jws_copy);
-        return -1; // Invalid JWS format
+    // Clean up key
+    psa_destroy_key(key_id);
+    
+    lcore_crypto_unlock();
+    return result;
+}
+
+// Imported keys kept alive for the duration of one batch
+#define JOSE_BATCH_KEY_SLOTS 8
+
+typedef struct {
+    uint8_t key[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+    size_t key_len;
+    psa_key_id_t key_id;
+} jose_batch_key_slot_t;
+
+// Returns the imported key for public_key, importing it into a slot on a miss.
+// Slots are recycled round-robin; gateway batches are usually grouped by device.
+static int batch_key_lookup(
+    jose_batch_key_slot_t* slots,
+    size_t* used,
+    size_t* next,
+    const uint8_t* public_key,
+    size_t key_len,
+    psa_key_id_t* key_id
+) {
+    for (size_t i = 0; i < *used; i++) {
+        if (slots[i].key_len == key_len && memcmp(slots[i].key, public_key, key_len) == 0) {
+            *key_id = slots[i].key_id;
+            return 0;
+        }
     }
     
-    // Decode signature
-    uint8_t signature[128];
-    size_t sig_len = sizeof(signature);
-    if (base64url_decode(sig_b64, signature, &sig_len) != 0) {
-        free(jws_copy);
+    if (key_len > sizeof(slots[0].key)) {
         return -1;
     }
     
-    // Create signing input for verification
-    char signing_input[2048];
-    snprintf(signing_input, sizeof(signing_input), "%s.%s", header_b64, payload_b64);
-    
-    // Import public key for PSA (IoTeX pattern)
-    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
-    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_VERIFY_MESSAGE);
-    psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
-    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_PUBLIC_KEY(PSA_ECC_FAMILY_SECP_R1));
-    psa_set_key_bits(&attributes, 256); // P-256
+    jose_batch_key_slot_t* slot;
+    int fresh = (*used < JOSE_BATCH_KEY_SLOTS);
+    if (fresh) {
+        slot = &slots[(*used)++];
+    } else {
+        slot = &slots[*next];
+        *next = (*next + 1) % JOSE_BATCH_KEY_SLOTS;
+        psa_destroy_key(slot->key_id);
+        slot->key_len = 0;
+    }
+
+    if (import_public_key(public_key, key_len, &slot->key_id) != 0) {
+        // Give the slot back so it is never matched nor destroyed
+        slot->key_id = PSA_KEY_ID_NULL;
+        slot->key_len = 0;
+        if (fresh) {
+            (*used)--;
+        }
+        return -1;
+    }
+    memcpy(slot->key, public_key, key_len);
+    slot->key_len = key_len;
     
-    psa_key_id_t key_id;
-    status = psa_import_key(&attributes, public_key, key_len, &key_id);
+    *key_id = slot->key_id;
+    return 0;
+}
+
+int lcore_jose_verify_batch(
+    const lcore_jose_verify_item_t* items,
+    size_t count,
+    int* results
+) {
+    if (!items && count > 0) {
+        return -1;
+    }
+
+    // Hold the PSA lock and initialize once for the whole batch
+    lcore_crypto_lock();
+    psa_status_t status = psa_crypto_init();
     if (status != PSA_SUCCESS) {
-        psa_reset_key_attributes(&attributes);
-        free(jws_copy);
+        lcore_crypto_unlock();
         return -1;
     }
     
-    // Verify signature using ARM PSA
-    status = psa_verify_message(
-        key_id,
-        PSA_ALG_ECDSA(PSA_ALG_SHA_256),
-        (const uint8_t*)signing_input, strlen(signing_input),
-        signature, sig_len
-    );
+    jose_batch_key_slot_t slots[JOSE_BATCH_KEY_SLOTS];
+    size_t used = 0;
+    size_t next = 0;
+    int failed = 0;
     
-    // Clean up key
-    psa_destroy_key(key_id);
-    psa_reset_key_attributes(&attributes);
+    for (size_t i = 0; i < count; i++) {
+        const lcore_jose_verify_item_t* item = &items[i];
+        int result = -1;
+        psa_key_id_t key_id;
+        
+        if (item->jws && item->public_key && item->payload_buffer && item->payload_len &&
+            batch_key_lookup(slots, &used, &next, item->public_key, item->key_len, &key_id) == 0) {
+            result = verify_with_key(key_id, item->jws, item->jws_len,
+                                     item->payload_buffer, item->payload_len);
+        }
+        
+        if (results) {
+            results[i] = result;
+        }
+        if (result != 0) {
+            failed = 1;
+        }
+    }
     
-    if (status == PSA_SUCCESS) {
-        // Signature is valid, decode payload
-        size_t decoded_len = *payload_len;
-        if (base64url_decode(payload_b64, payload_buffer, &decoded_len) != 0) {
-            free(jws_copy);
-            return -1;
+    // Clean up keys
+    for (size_t i = 0; i < used; i++) {
+        if (slots[i].key_len > 0) {
+            psa_destroy_key(slots[i].key_id);
         }
-        *payload_len = decoded_len;
     }
     
-    free(jws_copy);
-    return (status == PSA_SUCCESS) ? 0 : -1;
-} 
\ No newline at end of file
+    lcore_crypto_unlock();
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,423 @@
+#include <lcore/jose_async.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+typedef enum {
+    REQUEST_FREE,
+    REQUEST_QUEUED,
+    REQUEST_RUNNING,
+    REQUEST_DONE,
+} request_state_t;
+
+typedef enum {
+    REQUEST_SIGN,
+    REQUEST_VERIFY,
+} request_kind_t;
+
+// One slot of the preallocated request pool
+typedef struct async_request {
+    struct async_request* next;
+    request_state_t state;
+    request_kind_t kind;
+    uint64_t id;
+    int result;
+
+    const uint8_t* input;       // payload (sign) or JWS (verify)
+    size_t input_len;
+    const uint8_t* key;
+    size_t key_len;
+    lcore_jose_alg_t alg;
+    void* output;               // JWS buffer (sign) or payload buffer (verify)
+    size_t* output_len;
+
+    lcore_jose_async_cb_t callback;
+    void* user_data;
+} async_request_t;
+
+// Singly linked FIFO of requests
+typedef struct {
+    async_request_t* head;
+    async_request_t* tail;
+} request_list_t;
+
+// Internal struct definition for the opaque type.
+struct lcore_jose_async {
+    pthread_mutex_t lock;
+    pthread_cond_t wakeup;
+    pthread_t worker;
+    int stopping;
+    int poll_depth;      // lcore_jose_async_poll() calls in progress
+    int free_requested;  // lcore_jose_async_free() was called from a callback
+
+    async_request_t* pool;
+    size_t pool_size;
+    request_list_t free_list;
+    request_list_t pending;
+    request_list_t completed;
+    uint64_t next_id;
+
+    int notify_fd[2]; // eventfd in both entries, or a pipe's read/write ends
+};
+
+static void list_push(request_list_t* list, async_request_t* req) {
+    req->next = NULL;
+    if (list->tail) {
+        list->tail->next = req;
+    } else {
+        list->head = req;
+    }
+    list->tail = req;
+}
+
+static async_request_t* list_pop(request_list_t* list) {
+    async_request_t* req = list->head;
+    if (req) {
+        list->head = req->next;
+        if (!list->head) {
+            list->tail = NULL;
+        }
+        req->next = NULL;
+    }
+    return req;
+}
+
+// Unlinks req from list; returns 0 if it was found
+static int list_remove(request_list_t* list, async_request_t* req) {
+    async_request_t* prev = NULL;
+    for (async_request_t* cur = list->head; cur; prev = cur, cur = cur->next) {
+        if (cur != req) {
+            continue;
+        }
+        if (prev) {
+            prev->next = cur->next;
+        } else {
+            list->head = cur->next;
+        }
+        if (list->tail == cur) {
+            list->tail = prev;
+        }
+        cur->next = NULL;
+        return 0;
+    }
+    return -1;
+}
+
+static int notify_open(lcore_jose_async_t* queue) {
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    queue->notify_fd[0] = fd;
+    queue->notify_fd[1] = fd;
+#else
+    if (pipe(queue->notify_fd) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(queue->notify_fd[i], F_SETFL, fcntl(queue->notify_fd[i], F_GETFL) | O_NONBLOCK);
+        fcntl(queue->notify_fd[i], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    return 0;
+}
+
+static void notify_close(lcore_jose_async_t* queue) {
+    close(queue->notify_fd[0]);
+    if (queue->notify_fd[1] != queue->notify_fd[0]) {
+        close(queue->notify_fd[1]);
+    }
+}
+
+// Makes the notification descriptor readable
+static void notify_signal(lcore_jose_async_t* queue) {
+    uint64_t one = 1;
+    ssize_t ret = write(queue->notify_fd[1], &one, queue->notify_fd[0] == queue->notify_fd[1] ? sizeof(one) : 1);
+    (void)ret; // A full pipe or saturated eventfd is already readable
+}
+
+// Resets the notification descriptor to not readable
+static void notify_drain(lcore_jose_async_t* queue) {
+    uint8_t drain[64];
+    while (read(queue->notify_fd[0], drain, queue->notify_fd[0] == queue->notify_fd[1] ? sizeof(uint64_t) : sizeof(drain)) > 0) {
+    }
+}
+
+static void* worker_main(void* arg) {
+    lcore_jose_async_t* queue = arg;
+
+    pthread_mutex_lock(&queue->lock);
+    for (;;) {
+        while (!queue->stopping && !queue->pending.head) {
+            pthread_cond_wait(&queue->wakeup, &queue->lock);
+        }
+        if (queue->stopping) {
+            break;
+        }
+
+        async_request_t* req = list_pop(&queue->pending);
+        req->state = REQUEST_RUNNING;
+        pthread_mutex_unlock(&queue->lock);
+
+        // lcore_jose_sign/verify take the SDK-wide PSA lock themselves
+        if (req->kind == REQUEST_SIGN) {
+            req->result = lcore_jose_sign(req->input, req->input_len, req->key, req->key_len,
+                                          req->alg, req->output, req->output_len);
+        } else {
+            req->result = lcore_jose_verify((const char*)req->input, req->input_len, req->key, req->key_len,
+                                            req->output, req->output_len);
+        }
+
+        pthread_mutex_lock(&queue->lock);
+        req->state = REQUEST_DONE;
+        int was_empty = (queue->completed.head == NULL);
+        list_push(&queue->completed, req);
+        if (was_empty) {
+            notify_signal(queue);
+        }
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return NULL;
+}
+
+lcore_jose_async_t* lcore_jose_async_create(size_t max_pending) {
+    if (max_pending == 0) {
+        return NULL;
+    }
+
+    lcore_jose_async_t* queue = calloc(1, sizeof(lcore_jose_async_t));
+    if (!queue) {
+        return NULL;
+    }
+
+    queue->pool = calloc(max_pending, sizeof(async_request_t));
+    if (!queue->pool) {
+        free(queue);
+        return NULL;
+    }
+    queue->pool_size = max_pending;
+    for (size_t i = 0; i < max_pending; i++) {
+        list_push(&queue->free_list, &queue->pool[i]);
+    }
+    queue->next_id = 1;
+
+    if (notify_open(queue) != 0) {
+        free(queue->pool);
+        free(queue);
+        return NULL;
+    }
+
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->wakeup, NULL);
+
+    if (pthread_create(&queue->worker, NULL, worker_main, queue) != 0) {
+        pthread_cond_destroy(&queue->wakeup);
+        pthread_mutex_destroy(&queue->lock);
+        notify_close(queue);
+        free(queue->pool);
+        free(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+static void queue_destroy(lcore_jose_async_t* queue) {
+    pthread_mutex_lock(&queue->lock);
+    queue->stopping = 1;
+    pthread_cond_signal(&queue->wakeup);
+    pthread_mutex_unlock(&queue->lock);
+
+    pthread_join(queue->worker, NULL);
+
+    pthread_cond_destroy(&queue->wakeup);
+    pthread_mutex_destroy(&queue->lock);
+    notify_close(queue);
+    free(queue->pool);
+    free(queue);
+}
+
+void lcore_jose_async_free(lcore_jose_async_t* queue) {
+    if (!queue) {
+        return;
+    }
+
+    // From inside a callback, leave the teardown to the outermost poll
+    pthread_mutex_lock(&queue->lock);
+    if (queue->poll_depth > 0) {
+        queue->free_requested = 1;
+        pthread_mutex_unlock(&queue->lock);
+        return;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    queue_destroy(queue);
+}
+
+static int submit(lcore_jose_async_t* queue, const async_request_t* params, uint64_t* request_id) {
+    pthread_mutex_lock(&queue->lock);
+
+    if (queue->free_requested) {
+        pthread_mutex_unlock(&queue->lock);
+        return -1;
+    }
+
+    async_request_t* req = list_pop(&queue->free_list);
+    if (!req) {
+        pthread_mutex_unlock(&queue->lock);
+        return -3; // Backpressure: too many outstanding requests
+    }
+
+    *req = *params;
+    req->state = REQUEST_QUEUED;
+    req->id = queue->next_id++;
+    list_push(&queue->pending, req);
+
+    if (request_id) {
+        *request_id = req->id;
+    }
+
+    pthread_cond_signal(&queue->wakeup);
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+int lcore_jose_async_sign(
+    lcore_jose_async_t* queue,
+    const uint8_t* payload,
+    size_t payload_len,
+    const uint8_t* private_key,
+    size_t key_len,
+    lcore_jose_alg_t alg,
+    char* buffer,
+    size_t* buffer_len,
+    lcore_jose_async_cb_t callback,
+    void* user_data,
+    uint64_t* request_id
+) {
+    if (!queue || !payload || !private_key || !buffer || !buffer_len || !callback) {
+        return -1;
+    }
+
+    async_request_t params = {
+        .kind = REQUEST_SIGN,
+        .input = payload,
+        .input_len = payload_len,
+        .key = private_key,
+        .key_len = key_len,
+        .alg = alg,
+        .output = buffer,
+        .output_len = buffer_len,
+        .callback = callback,
+        .user_data = user_data,
+    };
+    return submit(queue, &params, request_id);
+}
+
+int lcore_jose_async_verify(
+    lcore_jose_async_t* queue,
+    const char* jws,
+    size_t jws_len,
+    const uint8_t* public_key,
+    size_t key_len,
+    uint8_t* payload_buffer,
+    size_t* payload_len,
+    lcore_jose_async_cb_t callback,
+    void* user_data,
+    uint64_t* request_id
+) {
+    if (!queue || !jws || !public_key || !payload_buffer || !payload_len || !callback) {
+        return -1;
+    }
+
+    async_request_t params = {
+        .kind = REQUEST_VERIFY,
+        .input = (const uint8_t*)jws,
+        .input_len = jws_len,
+        .key = public_key,
+        .key_len = key_len,
+        .output = payload_buffer,
+        .output_len = payload_len,
+        .callback = callback,
+        .user_data = user_data,
+    };
+    return submit(queue, &params, request_id);
+}
+
+int lcore_jose_async_cancel(lcore_jose_async_t* queue, uint64_t request_id) {
+    if (!queue) {
+        return -1;
+    }
+
+    int result = -1;
+    pthread_mutex_lock(&queue->lock);
+    for (size_t i = 0; i < queue->pool_size; i++) {
+        async_request_t* req = &queue->pool[i];
+        if (req->id == request_id && req->state == REQUEST_QUEUED &&
+            list_remove(&queue->pending, req) == 0) {
+            req->state = REQUEST_FREE;
+            list_push(&queue->free_list, req);
+            result = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return result;
+}
+
+int lcore_jose_async_fd(const lcore_jose_async_t* queue) {
+    if (!queue) {
+        return -1;
+    }
+    return queue->notify_fd[0];
+}
+
+size_t lcore_jose_async_poll(lcore_jose_async_t* queue, size_t max_completions) {
+    if (!queue) {
+        return 0;
+    }
+
+    size_t delivered = 0;
+    pthread_mutex_lock(&queue->lock);
+    queue->poll_depth++;
+    notify_drain(queue);
+
+    while (!queue->free_requested && queue->completed.head &&
+           (max_completions == 0 || delivered < max_completions)) {
+        async_request_t* req = list_pop(&queue->completed);
+        uint64_t id = req->id;
+        int result = req->result;
+        lcore_jose_async_cb_t callback = req->callback;
+        void* user_data = req->user_data;
+
+        // Recycle the slot before the callback so it may submit again
+        req->state = REQUEST_FREE;
+        list_push(&queue->free_list, req);
+
+        pthread_mutex_unlock(&queue->lock);
+        callback(id, result, user_data);
+        delivered++;
+        pthread_mutex_lock(&queue->lock);
+    }
+
+    // Stay readable while completions remain undelivered
+    if (!queue->free_requested && queue->completed.head) {
+        notify_signal(queue);
+    }
+    queue->poll_depth--;
+    int release = queue->free_requested && queue->poll_depth == 0;
+    pthread_mutex_unlock(&queue->lock);
+
+    if (release) {
+        queue_destroy(queue);
+    }
+    return delivered;
+}
@@ -0,0 +1,23 @@
+#ifndef LCORE_JWS_H
+#define LCORE_JWS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compact JWS split into its segments, with the signature already decoded.
+// jws[0..payload_end) is the signing input.
+typedef struct {
+    size_t header_end;      // offset of the first '.'
+    size_t payload_end;     // offset of the second '.'
+    uint8_t signature[128];
+    size_t signature_len;
+} lcore_jws_parts_t;
+
+// Splits a compact JWS, checks the header encoding and decodes the signature.
+// This is everything lcore_jose_verify() does before the signature check.
+int lcore_jws_parse(const char* jws, size_t jws_len, lcore_jws_parts_t* parts);
+
+// Decodes the payload segment of a parsed JWS; *payload_len is the buffer size in, decoded size out
+int lcore_jws_decode_payload(const char* jws, const lcore_jws_parts_t* parts, uint8_t* payload, size_t* payload_len);
+
+#endif // LCORE_JWS_H
@@ -0,0 +1,103 @@
+#include <lcore/key.h>
+#include <psa/crypto.h>
+#include "jose/crypto_lock.h"
+
+// Persistent device keys in PSA storage (IoTeX pattern)
+
+static int key_id_valid(lcore_key_id_t key_id) {
+    return key_id >= PSA_KEY_ID_USER_MIN && key_id <= PSA_KEY_ID_USER_MAX;
+}
+
+int lcore_key_provision(lcore_key_id_t key_id, const uint8_t* private_key, size_t key_len) {
+    if (!key_id_valid(key_id) || !private_key) {
+        return -1;
+    }
+
+    lcore_crypto_lock();
+    psa_status_t status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        lcore_crypto_unlock();
+        return -1;
+    }
+
+    // Persistent P-256 signing key under a fixed id
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_set_key_id(&attributes, key_id);
+    psa_set_key_lifetime(&attributes, PSA_KEY_LIFETIME_PERSISTENT);
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_MESSAGE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+    psa_set_key_bits(&attributes, 256); // P-256
+
+    psa_key_id_t imported;
+    status = psa_import_key(&attributes, private_key, key_len, &imported);
+    psa_reset_key_attributes(&attributes);
+    lcore_crypto_unlock();
+
+    if (status == PSA_ERROR_ALREADY_EXISTS) {
+        return -3; // Already provisioned
+    }
+    return (status == PSA_SUCCESS) ? 0 : -1;
+}
+
+int lcore_key_is_provisioned(lcore_key_id_t key_id) {
+    if (!key_id_valid(key_id)) {
+        return 0;
+    }
+
+    lcore_crypto_lock();
+    psa_status_t status = psa_crypto_init();
+    if (status == PSA_SUCCESS) {
+        psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+        status = psa_get_key_attributes(key_id, &attributes);
+        psa_reset_key_attributes(&attributes);
+    }
+    lcore_crypto_unlock();
+
+    return (status == PSA_SUCCESS) ? 1 : 0;
+}
+
+int lcore_key_export_public(lcore_key_id_t key_id, uint8_t* buffer, size_t* len) {
+    if (!key_id_valid(key_id) || !buffer || !len) {
+        return -1;
+    }
+
+    lcore_crypto_lock();
+    size_t exported_len = 0;
+    psa_status_t status = psa_crypto_init();
+    if (status == PSA_SUCCESS) {
+        status = psa_export_public_key(key_id, buffer, *len, &exported_len);
+    }
+    lcore_crypto_unlock();
+    if (status != PSA_SUCCESS) {
+        return -1;
+    }
+
+    *len = exported_len;
+    return 0;
+}
+
+lcore_did_document_t* lcore_key_did_create(lcore_key_id_t key_id) {
+    uint8_t public_key[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+    size_t public_key_len = sizeof(public_key);
+    if (lcore_key_export_public(key_id, public_key, &public_key_len) != 0) {
+        return NULL;
+    }
+
+    return lcore_did_create(public_key, public_key_len);
+}
+
+int lcore_key_destroy(lcore_key_id_t key_id) {
+    if (!key_id_valid(key_id)) {
+        return -1;
+    }
+
+    lcore_crypto_lock();
+    psa_status_t status = psa_crypto_init();
+    if (status == PSA_SUCCESS) {
+        status = psa_destroy_key(key_id);
+    }
+    lcore_crypto_unlock();
+
+    return (status == PSA_SUCCESS) ? 0 : -1;
+}
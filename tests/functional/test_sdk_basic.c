@@ -3,6 +3,11 @@
 #include <string.h>
 #include <lcore/did.h>
 #include <lcore/jose.h>
+#include <lcore/jose_async.h>
+#include <lcore/claims.h>
+#include <lcore/delta.h>
+#include <lcore/key.h>
+#include <poll.h>
 
 // Test key material (simulated P-256 private key - 32 bytes)
 static const uint8_t test_private_key[32] = {
@@ -20,6 +25,19 @@ static const uint8_t test_public_key[32] = {
     0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc0
 };
 
+// Uncompressed P-256 public key matching test_private_key
+static const uint8_t test_verify_key[65] = {
+    0x04, 0x51, 0x5c, 0x3d, 0x6e, 0xb9, 0xe3, 0x96,
+    0xb9, 0x04, 0xd3, 0xfe, 0xca, 0x7f, 0x54, 0xfd,
+    0xcd, 0x0c, 0xc1, 0xe9, 0x97, 0xbf, 0x37, 0x5d,
+    0xca, 0x51, 0x5a, 0xd0, 0xa6, 0xc3, 0xb4, 0x03,
+    0x5f, 0x45, 0x36, 0xbe, 0x3a, 0x50, 0xf3, 0x18,
+    0xfb, 0xf9, 0xa5, 0x47, 0x59, 0x02, 0xa2, 0x21,
+    0x50, 0x2b, 0xef, 0x0d, 0x57, 0xe0, 0x8c, 0x53,
+    0xb2, 0xcc, 0x0a, 0x56, 0xf1, 0x7d, 0x9f, 0x93,
+    0x54
+};
+
 int test_did_generation() {
     printf("=== Testing DID Generation ===\n");
     
@@ -102,6 +120,439 @@ int test_jose_signing() {
     return 0;
 }
 
+int test_jose_verify_batch() {
+    printf("=== Testing JOSE Batch Verification ===\n");
+    
+    const char* readings[3] = {
+        "{\"temperature\":23.4,\"humidity\":52}",
+        "{\"temperature\":23.5,\"humidity\":51}",
+        "{\"temperature\":23.7,\"humidity\":51}",
+    };
+    
+    char jws_buffers[3][2048];
+    uint8_t payload_buffers[3][256];
+    size_t payload_lens[3];
+    lcore_jose_verify_item_t items[3];
+    int results[3];
+    
+    for (int i = 0; i < 3; i++) {
+        size_t jws_len = sizeof(jws_buffers[i]);
+        if (lcore_jose_sign(
+                (const uint8_t*)readings[i], strlen(readings[i]),
+                test_private_key, sizeof(test_private_key),
+                LCORE_JOSE_ALG_ES256,
+                jws_buffers[i], &jws_len) != 0) {
+            printf("❌ JOSE Signing Failed for reading %d\n", i);
+            return -1;
+        }
+        
+        payload_lens[i] = sizeof(payload_buffers[i]);
+        items[i].jws = jws_buffers[i];
+        items[i].jws_len = jws_len;
+        items[i].public_key = test_verify_key;
+        items[i].key_len = sizeof(test_verify_key);
+        items[i].payload_buffer = payload_buffers[i];
+        items[i].payload_len = &payload_lens[i];
+    }
+    
+    if (lcore_jose_verify_batch(items, 3, results) != 0) {
+        printf("❌ Batch Verification Failed (%d, %d, %d)\n", results[0], results[1], results[2]);
+        return -1;
+    }
+    
+    for (int i = 0; i < 3; i++) {
+        if (payload_lens[i] != strlen(readings[i]) ||
+            memcmp(payload_buffers[i], readings[i], payload_lens[i]) != 0) {
+            printf("❌ Batch Payload Mismatch for reading %d\n", i);
+            return -1;
+        }
+    }
+    printf("✅ Batch of 3 Verified, Payloads Recovered\n");
+    
+    // Tamper with the middle token's payload; only that item may fail
+    char* payload_start = strchr(jws_buffers[1], '.') + 1;
+    *payload_start = (*payload_start == 'e') ? 'f' : 'e';
+    for (int i = 0; i < 3; i++) {
+        payload_lens[i] = sizeof(payload_buffers[i]);
+    }
+    
+    if (lcore_jose_verify_batch(items, 3, results) == 0 ||
+        results[0] != 0 || results[1] == 0 || results[2] != 0) {
+        printf("❌ Tampered Token Not Pinpointed (%d, %d, %d)\n", results[0], results[1], results[2]);
+        return -1;
+    }
+    printf("✅ Tampered Token Rejected, Others Accepted\n");
+
+    // Restore the token and give the middle item a key that is not on the curve
+    *payload_start = (*payload_start == 'e') ? 'f' : 'e';
+    uint8_t bad_key[sizeof(test_verify_key)];
+    memcpy(bad_key, test_verify_key, sizeof(bad_key));
+    bad_key[sizeof(bad_key) - 1] ^= 0x01;
+    items[1].public_key = bad_key;
+    for (int i = 0; i < 3; i++) {
+        payload_lens[i] = sizeof(payload_buffers[i]);
+    }
+
+    if (lcore_jose_verify_batch(items, 3, results) == 0 ||
+        results[0] != 0 || results[1] == 0 || results[2] != 0) {
+        printf("❌ Bad Public Key Not Pinpointed (%d, %d, %d)\n", results[0], results[1], results[2]);
+        return -1;
+    }
+    printf("✅ Bad Public Key Rejected, Others Accepted\n");
+
+    printf("✅ JOSE Batch Verification: SUCCESS\n\n");
+    return 0;
+}
+
+int test_claims_writer() {
+    printf("=== Testing Claims Writer ===\n");
+    
+    // Plain JSON output
+    const char* expected = "{\"temperature\":25.1,\"humidity\":48,\"pressure\":-0.05,"
+                           "\"location\":\"lab \\\"A\\\"\",\"calibrated\":true}";
+    char json_buffer[256];
+    size_t json_len = 0;
+    lcore_claims_t claims;
+    lcore_claims_init(&claims, json_buffer, sizeof(json_buffer));
+    lcore_claims_add_double(&claims, "temperature", 25.1, 2);
+    lcore_claims_add_int(&claims, "humidity", 48);
+    lcore_claims_add_double(&claims, "pressure", -0.049999, 2);
+    lcore_claims_add_string(&claims, "location", "lab \"A\"");
+    lcore_claims_add_bool(&claims, "calibrated", 1);
+    
+    if (lcore_claims_finish(&claims, &json_len) != 0 || strcmp(json_buffer, expected) != 0 ||
+        json_len != strlen(expected)) {
+        printf("❌ Claims JSON Mismatch: %s\n", json_buffer);
+        return -1;
+    }
+    printf("✅ Claims JSON: %s\n", json_buffer);
+
+    // A finished writer is closed: finishing again changes nothing, appends fail
+    size_t again_len = 0;
+    if (lcore_claims_finish(&claims, &again_len) != 0 || again_len != json_len ||
+        strcmp(json_buffer, expected) != 0 || lcore_claims_add_int(&claims, "extra", 1) != -1 ||
+        strcmp(json_buffer, expected) != 0) {
+        printf("❌ Claims Writer Modified After Finish: %s\n", json_buffer);
+        return -1;
+    }
+    printf("✅ Claims Finish: Idempotent\n");
+
+    // Overflow is reported, not truncated silently
+    char small_buffer[8];
+    lcore_claims_init(&claims, small_buffer, sizeof(small_buffer));
+    lcore_claims_add_int(&claims, "humidity", 48);
+    if (lcore_claims_finish(&claims, NULL) != -2) {
+        printf("❌ Claims Overflow Not Reported\n");
+        return -1;
+    }
+    printf("✅ Claims Overflow: Reported\n");
+
+    // A JWS buffer too small for the header reports the size to retry with
+    char tiny_buffer[16];
+    size_t tiny_len = 0;
+    lcore_jose_claims_init(&claims, LCORE_JOSE_ALG_ES256, tiny_buffer, sizeof(tiny_buffer));
+    lcore_claims_add_int(&claims, "humidity", 48);
+    if (lcore_jose_sign_claims(&claims, test_private_key, sizeof(test_private_key), &tiny_len) != -2 ||
+        tiny_len <= sizeof(tiny_buffer)) {
+        printf("❌ Claims JWS Header Overflow Not Reported (%zu)\n", tiny_len);
+        return -1;
+    }
+    printf("✅ Claims JWS Header Overflow: Reported (needs %zu)\n", tiny_len);
+    
+    // Encode straight into a JWS and check it round-trips through verification
+    char jws_buffer[2048];
+    size_t jws_len = 0;
+    lcore_jose_claims_init(&claims, LCORE_JOSE_ALG_ES256, jws_buffer, sizeof(jws_buffer));
+    lcore_claims_add_double(&claims, "temperature", 25.1, 2);
+    lcore_claims_add_int(&claims, "humidity", 48);
+    lcore_claims_add_double(&claims, "pressure", -0.049999, 2);
+    lcore_claims_add_string(&claims, "location", "lab \"A\"");
+    lcore_claims_add_bool(&claims, "calibrated", 1);
+    
+    if (lcore_jose_sign_claims(&claims, test_private_key, sizeof(test_private_key), &jws_len) != 0) {
+        printf("❌ Claims Signing Failed\n");
+        return -1;
+    }
+    
+    uint8_t payload_buffer[256];
+    size_t payload_len = sizeof(payload_buffer);
+    if (lcore_jose_verify(jws_buffer, jws_len, test_verify_key, sizeof(test_verify_key),
+                          payload_buffer, &payload_len) != 0 ||
+        payload_len != strlen(expected) || memcmp(payload_buffer, expected, payload_len) != 0) {
+        printf("❌ Claims JWS Did Not Verify\n");
+        return -1;
+    }
+    printf("✅ Claims JWS Verified (%zu characters)\n", jws_len);
+    
+    printf("✅ Claims Writer: SUCCESS\n\n");
+    return 0;
+}
+
+int test_delta_pipeline() {
+    printf("=== Testing Delta Payload Pipeline ===\n");
+    
+    const char* readings[4] = {
+        "{\"temperature\":25.1,\"humidity\":48,\"location\":\"test_lab\",\"door_open\":false}",
+        "{\"temperature\":25.15,\"humidity\":48,\"location\":\"test_lab\",\"door_open\":false}",
+        "{\"temperature\":25.2,\"humidity\":47,\"location\":\"test_lab\",\"door_open\":true}",
+        "{\"temperature\":25.2,\"humidity\":47,\"pressure\":1013.2}",
+    };
+    // Decoded readings come back in canonical number form
+    const char* expected[4] = {
+        "{\"temperature\":25.1,\"humidity\":48,\"location\":\"test_lab\",\"door_open\":false}",
+        "{\"temperature\":25.15,\"humidity\":48,\"location\":\"test_lab\",\"door_open\":false}",
+        "{\"temperature\":25.2,\"humidity\":47,\"location\":\"test_lab\",\"door_open\":true}",
+        "{\"temperature\":25.2,\"humidity\":47,\"pressure\":1013.2}",
+    };
+    
+    lcore_delta_ctx_t encoder;
+    lcore_delta_ctx_t decoder;
+    lcore_delta_init(&encoder, 0);
+    lcore_delta_init(&decoder, 0);
+    
+    uint8_t frames[4][128];
+    size_t frame_lens[4];
+    for (int i = 0; i < 4; i++) {
+        // Sign the frame, then verify and decode it as the node would
+        frame_lens[i] = sizeof(frames[i]);
+        if (lcore_delta_encode(&encoder, readings[i], strlen(readings[i]), frames[i], &frame_lens[i]) != 0) {
+            printf("❌ Delta Encoding Failed for reading %d\n", i);
+            return -1;
+        }
+        
+        char jws_buffer[2048];
+        size_t jws_len = sizeof(jws_buffer);
+        uint8_t payload_buffer[256];
+        size_t payload_len = sizeof(payload_buffer);
+        if (lcore_jose_sign(frames[i], frame_lens[i], test_private_key, sizeof(test_private_key),
+                            LCORE_JOSE_ALG_ES256, jws_buffer, &jws_len) != 0 ||
+            lcore_jose_verify(jws_buffer, jws_len, test_verify_key, sizeof(test_verify_key),
+                              payload_buffer, &payload_len) != 0) {
+            printf("❌ Delta Frame Signing Failed for reading %d\n", i);
+            return -1;
+        }
+        
+        char json_buffer[256];
+        size_t json_len = sizeof(json_buffer);
+        if (lcore_delta_decode(&decoder, payload_buffer, payload_len, json_buffer, &json_len) != 0 ||
+            strcmp(json_buffer, expected[i]) != 0) {
+            printf("❌ Delta Round-Trip Mismatch for reading %d: %s\n", i, json_buffer);
+            return -1;
+        }
+        printf("✅ Reading %d: %zu JSON bytes -> %zu frame bytes\n", i, strlen(readings[i]), frame_lens[i]);
+    }
+    
+    // A delta frame that skips its predecessor must be refused
+    lcore_delta_ctx_t late_decoder;
+    lcore_delta_init(&late_decoder, 0);
+    char json_buffer[256];
+    size_t json_len = sizeof(json_buffer);
+    if (lcore_delta_decode(&late_decoder, frames[0], frame_lens[0], json_buffer, &json_len) != 0) {
+        printf("❌ Keyframe Not Decoded\n");
+        return -1;
+    }
+    json_len = sizeof(json_buffer);
+    if (lcore_delta_decode(&late_decoder, frames[2], frame_lens[2], json_buffer, &json_len) != -3) {
+        printf("❌ Lost Frame Not Detected\n");
+        return -1;
+    }
+    printf("✅ Lost Frame Detected\n");
+    
+    printf("✅ Delta Payload Pipeline: SUCCESS\n\n");
+    return 0;
+}
+
+// Persistent storage id used by the key handle test
+#define TEST_KEY_ID 0x00004c43
+
+int test_key_handle() {
+    printf("=== Testing Persistent Key Handle ===\n");
+    
+    // A key left behind by an interrupted run is reported as already provisioned
+    int provisioned = lcore_key_provision(TEST_KEY_ID, test_private_key, sizeof(test_private_key));
+    if (provisioned != 0 && provisioned != -3) {
+        printf("❌ Key Provisioning Failed (error code: %d)\n", provisioned);
+        return -1;
+    }
+    if (!lcore_key_is_provisioned(TEST_KEY_ID) ||
+        lcore_key_provision(TEST_KEY_ID, test_private_key, sizeof(test_private_key)) != -3) {
+        printf("❌ Provisioned Key Not Found\n");
+        lcore_key_destroy(TEST_KEY_ID);
+        return -1;
+    }
+    printf("✅ Key Provisioned (id 0x%08x)\n", TEST_KEY_ID);
+    
+    int result = -1;
+    uint8_t public_key[65];
+    size_t public_key_len = sizeof(public_key);
+    char did_string[256];
+    char expected_did[256];
+    size_t did_len = sizeof(did_string);
+    size_t expected_len = sizeof(expected_did);
+    lcore_did_document_t* did_doc = lcore_key_did_create(TEST_KEY_ID);
+    lcore_did_document_t* expected_doc = lcore_did_create(test_verify_key, sizeof(test_verify_key));
+    
+    if (lcore_key_export_public(TEST_KEY_ID, public_key, &public_key_len) != 0 ||
+        public_key_len != sizeof(test_verify_key) ||
+        memcmp(public_key, test_verify_key, public_key_len) != 0) {
+        printf("❌ Exported Public Key Mismatch\n");
+        goto cleanup;
+    }
+    printf("✅ Public Key Exported (%zu bytes)\n", public_key_len);
+    
+    if (!did_doc || !expected_doc ||
+        lcore_did_to_string(did_doc, did_string, &did_len) != 0 ||
+        lcore_did_to_string(expected_doc, expected_did, &expected_len) != 0 ||
+        strcmp(did_string, expected_did) != 0) {
+        printf("❌ DID From Key Handle Mismatch\n");
+        goto cleanup;
+    }
+    printf("✅ DID From Key Handle: %s\n", did_string);
+    
+    const char* sensor_data = "{\"temperature\":23.4,\"humidity\":52}";
+    char jws_buffer[2048];
+    size_t jws_len = sizeof(jws_buffer);
+    uint8_t payload_buffer[256];
+    size_t payload_len = sizeof(payload_buffer);
+    if (lcore_jose_sign_with_key(
+            (const uint8_t*)sensor_data, strlen(sensor_data),
+            TEST_KEY_ID, LCORE_JOSE_ALG_ES256,
+            jws_buffer, &jws_len) != 0 ||
+        lcore_jose_verify(jws_buffer, jws_len, public_key, public_key_len,
+                          payload_buffer, &payload_len) != 0 ||
+        payload_len != strlen(sensor_data) || memcmp(payload_buffer, sensor_data, payload_len) != 0) {
+        printf("❌ Signing With Key Handle Failed\n");
+        goto cleanup;
+    }
+    printf("✅ JWS Signed by Key Id and Verified\n");
+    result = 0;
+    
+cleanup:
+    lcore_did_free(did_doc);
+    lcore_did_free(expected_doc);
+    if (lcore_key_destroy(TEST_KEY_ID) != 0 || lcore_key_is_provisioned(TEST_KEY_ID)) {
+        printf("❌ Key Not Removed From Storage\n");
+        result = -1;
+    }
+    
+    if (result == 0) {
+        printf("✅ Persistent Key Handle: SUCCESS\n\n");
+    }
+    return result;
+}
+
+typedef struct {
+    int completed;
+    int failed;
+} async_test_state_t;
+
+static void async_test_callback(uint64_t request_id, int result, void* user_data) {
+    async_test_state_t* state = user_data;
+    (void)request_id;
+    state->completed++;
+    if (result != 0) {
+        state->failed++;
+    }
+}
+
+// Shuts the queue down from its first completion, as an event loop would
+static void async_free_callback(uint64_t request_id, int result, void* user_data) {
+    lcore_jose_async_t** queue = user_data;
+    (void)request_id;
+    (void)result;
+    if (*queue) {
+        lcore_jose_async_free(*queue);
+        *queue = NULL;
+    }
+}
+
+int test_jose_async() {
+    printf("=== Testing JOSE Async Queue ===\n");
+    
+    const char* sensor_data = "{\"temperature\":23.4,\"humidity\":52}";
+    char jws_buffers[3][2048];
+    size_t jws_lens[3];
+    uint64_t request_ids[3];
+    async_test_state_t state = {0, 0};
+    
+    lcore_jose_async_t* queue = lcore_jose_async_create(2);
+    if (!queue || lcore_jose_async_fd(queue) < 0) {
+        printf("❌ Failed to create async queue\n");
+        lcore_jose_async_free(queue);
+        return -1;
+    }
+    
+    // Two requests fit, the third must be refused until completions are polled
+    int submit_results[3];
+    for (int i = 0; i < 3; i++) {
+        jws_lens[i] = sizeof(jws_buffers[i]);
+        submit_results[i] = lcore_jose_async_sign(
+            queue,
+            (const uint8_t*)sensor_data, strlen(sensor_data),
+            test_private_key, sizeof(test_private_key),
+            LCORE_JOSE_ALG_ES256,
+            jws_buffers[i], &jws_lens[i],
+            async_test_callback, &state, &request_ids[i]
+        );
+    }
+    
+    if (submit_results[0] != 0 || submit_results[1] != 0 || submit_results[2] != -3) {
+        printf("❌ Backpressure Not Applied (%d, %d, %d)\n", submit_results[0], submit_results[1], submit_results[2]);
+        lcore_jose_async_free(queue);
+        return -1;
+    }
+    printf("✅ Backpressure: Third Request Refused\n");
+    
+    // The second request may still be queued; if so it must never complete
+    int expected = 2;
+    if (lcore_jose_async_cancel(queue, request_ids[1]) == 0) {
+        expected = 1;
+        printf("✅ Queued Request Cancelled\n");
+    }
+    
+    struct pollfd pfd = { .fd = lcore_jose_async_fd(queue), .events = POLLIN };
+    while (state.completed < expected) {
+        if (poll(&pfd, 1, 5000) <= 0) {
+            printf("❌ Timed Out Waiting for Completion\n");
+            lcore_jose_async_free(queue);
+            return -1;
+        }
+        lcore_jose_async_poll(queue, 0);
+    }
+    
+    lcore_jose_async_free(queue);
+    
+    if (state.completed != expected || state.failed != 0) {
+        printf("❌ Async Completions Wrong (%d completed, %d failed)\n", state.completed, state.failed);
+        return -1;
+    }
+    printf("✅ %d Signing Request(s) Completed via Poll FD\n", state.completed);
+    
+    // Freeing the queue from a callback is deferred until poll returns
+    lcore_jose_async_t* closing = lcore_jose_async_create(1);
+    jws_lens[0] = sizeof(jws_buffers[0]);
+    if (!closing || lcore_jose_async_sign(closing, (const uint8_t*)sensor_data, strlen(sensor_data),
+                                          test_private_key, sizeof(test_private_key), LCORE_JOSE_ALG_ES256,
+                                          jws_buffers[0], &jws_lens[0], async_free_callback, &closing, NULL) != 0) {
+        printf("❌ Failed to Submit to Closing Queue\n");
+        lcore_jose_async_free(closing);
+        return -1;
+    }
+    pfd.fd = lcore_jose_async_fd(closing);
+    while (closing) {
+        if (poll(&pfd, 1, 5000) <= 0) {
+            printf("❌ Timed Out Waiting for Closing Queue\n");
+            lcore_jose_async_free(closing);
+            return -1;
+        }
+        lcore_jose_async_poll(closing, 0);
+    }
+    printf("✅ Queue Freed From Its Own Callback\n");
+    
+    printf("✅ JOSE Async Queue: SUCCESS\n\n");
+    return 0;
+}
+
 int test_lcore_node_format() {
     printf("=== Testing lcore-node Format Compatibility ===\n");
     
@@ -161,7 +612,32 @@ int main() {
         result = -1;
     }
     
-    // Test 3: Format Compatibility
+    // Test 3: Batch Verification
+    if (test_jose_verify_batch() != 0) {
+        result = -1;
+    }
+    
+    // Test 4: Async Queue
+    if (test_jose_async() != 0) {
+        result = -1;
+    }
+    
+    // Test 5: Claims Writer
+    if (test_claims_writer() != 0) {
+        result = -1;
+    }
+    
+    // Test 6: Delta Payload Pipeline
+    if (test_delta_pipeline() != 0) {
+        result = -1;
+    }
+    
+    // Test 7: Persistent Key Handle
+    if (test_key_handle() != 0) {
+        result = -1;
+    }
+    
+    // Test 8: Format Compatibility
     if (test_lcore_node_format() != 0) {
         result = -1;
     }
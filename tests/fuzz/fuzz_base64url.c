@@ -0,0 +1,62 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jose/base64url.h"
+
+#define FUZZ_MAX_INPUT 4096
+
+static int is_base64url_char(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '_';
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size > FUZZ_MAX_INPUT) {
+        return 0;
+    }
+    
+    // Decoding untrusted text must stay within the output buffer
+    uint8_t decoded[FUZZ_MAX_INPUT];
+    size_t decoded_len = sizeof(decoded);
+    char encoded[(FUZZ_MAX_INPUT / 3 + 1) * 4 + 1];
+    if (lcore_b64url_decode((const char*)data, size, decoded, &decoded_len) == 0) {
+        if (decoded_len > (size * 3) / 4) {
+            abort();
+        }
+        
+        // Property: only [A-Za-z0-9_-] is accepted, so '+', '/' and '=' never decode
+        for (size_t i = 0; i < size; i++) {
+            if (!is_base64url_char(data[i])) {
+                abort();
+            }
+        }
+        
+        // Property: accepted text is canonical, so it re-encodes to itself
+        if (lcore_b64url_encode(decoded, decoded_len, encoded, sizeof(encoded)) != 0 ||
+            strlen(encoded) != size || memcmp(encoded, data, size) != 0) {
+            abort();
+        }
+    }
+    
+    // Property: decode(encode(x)) == x and the encoded length is as predicted
+    if (lcore_b64url_encode(data, size, encoded, sizeof(encoded)) != 0) {
+        abort();
+    }
+    size_t encoded_len = strlen(encoded);
+    if (encoded_len != lcore_b64url_encoded_len(size)) {
+        abort();
+    }
+    
+    uint8_t roundtrip[FUZZ_MAX_INPUT];
+    size_t roundtrip_len = sizeof(roundtrip);
+    if (lcore_b64url_decode(encoded, encoded_len, roundtrip, &roundtrip_len) != 0 ||
+        roundtrip_len != size || memcmp(roundtrip, data, size) != 0) {
+        abort();
+    }
+    
+    // Property: a one-byte-short output buffer is rejected, not overrun
+    if (lcore_b64url_encode(data, size, encoded, encoded_len) == 0) {
+        abort();
+    }
+    
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Standalone replacement for the libFuzzer main(): replays a corpus through
+// the fuzz target and reports parse throughput over the same inputs.
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+} corpus_input_t;
+
+typedef struct {
+    corpus_input_t* inputs;
+    size_t count;
+    size_t capacity;
+    size_t total_bytes;
+} corpus_t;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int corpus_add_file(corpus_t* corpus, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("❌ Cannot open %s\n", path);
+        return -1;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return -1;
+    }
+    
+    // Inputs are copied to exact-size allocations so overreads are caught by sanitizers
+    uint8_t* data = malloc(size > 0 ? (size_t)size : 1);
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    
+    if (corpus->count == corpus->capacity) {
+        size_t capacity = corpus->capacity ? corpus->capacity * 2 : 64;
+        corpus_input_t* inputs = realloc(corpus->inputs, capacity * sizeof(corpus_input_t));
+        if (!inputs) {
+            free(data);
+            return -1;
+        }
+        corpus->inputs = inputs;
+        corpus->capacity = capacity;
+    }
+    
+    corpus->inputs[corpus->count].data = data;
+    corpus->inputs[corpus->count].size = (size_t)size;
+    corpus->count++;
+    corpus->total_bytes += (size_t)size;
+    return 0;
+}
+
+static int corpus_add_path(corpus_t* corpus, const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        printf("❌ Cannot stat %s\n", path);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return corpus_add_file(corpus, path);
+    }
+    
+    DIR* dir = opendir(path);
+    if (!dir) {
+        printf("❌ Cannot open directory %s\n", path);
+        return -1;
+    }
+    
+    int result = 0;
+    struct dirent* entry;
+    while (result == 0 && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        char child[4096];
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (stat(child, &st) == 0 && S_ISREG(st.st_mode)) {
+            result = corpus_add_file(corpus, child);
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+static void usage(const char* argv0) {
+    printf("Usage: %s [-iterations=N] [-min_rate=INPUTS_PER_SEC] <file|dir>...\n", argv0);
+}
+
+int main(int argc, char* argv[]) {
+    unsigned long iterations = 1;
+    double min_rate = 0.0;
+    corpus_t corpus = { NULL, 0, 0, 0 };
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-iterations=", 12) == 0) {
+            iterations = strtoul(argv[i] + 12, NULL, 10);
+        } else if (strncmp(argv[i], "-min_rate=", 10) == 0) {
+            min_rate = strtod(argv[i] + 10, NULL);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else if (corpus_add_path(&corpus, argv[i]) != 0) {
+            return 2;
+        }
+    }
+    
+    if (corpus.count == 0 || iterations == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    
+    printf("📋 Corpus: %zu inputs, %zu bytes\n", corpus.count, corpus.total_bytes);
+    
+    // A crash or abort() in the target fails the run; completing it means every input passed
+    double start = now_seconds();
+    for (unsigned long iter = 0; iter < iterations; iter++) {
+        for (size_t i = 0; i < corpus.count; i++) {
+            LLVMFuzzerTestOneInput(corpus.inputs[i].data, corpus.inputs[i].size);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    
+    double executed = (double)corpus.count * iterations;
+    double rate = elapsed > 0 ? executed / elapsed : 0.0;
+    double mbps = elapsed > 0 ? (double)corpus.total_bytes * iterations / elapsed / 1e6 : 0.0;
+    printf("✅ Replayed %.0f inputs in %.3f s\n", executed, elapsed);
+    printf("📏 Throughput: %.0f inputs/s, %.2f MB/s\n", rate, mbps);
+    
+    for (size_t i = 0; i < corpus.count; i++) {
+        free(corpus.inputs[i].data);
+    }
+    free(corpus.inputs);
+    
+    if (min_rate > 0.0 && elapsed > 0 && rate < min_rate) {
+        printf("❌ Throughput below %.0f inputs/s\n", min_rate);
+        return 1;
+    }
+    return 0;
+}
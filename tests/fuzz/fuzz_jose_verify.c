@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+#include <lcore/jose.h>
+#include "jose/base64url.h"
+
+// Uncompressed P-256 public key matching the functional test private key;
+// the valid_*.jws seeds in corpus/jose_verify are signed with it
+static const uint8_t test_verify_key[65] = {
+    0x04, 0x51, 0x5c, 0x3d, 0x6e, 0xb9, 0xe3, 0x96,
+    0xb9, 0x04, 0xd3, 0xfe, 0xca, 0x7f, 0x54, 0xfd,
+    0xcd, 0x0c, 0xc1, 0xe9, 0x97, 0xbf, 0x37, 0x5d,
+    0xca, 0x51, 0x5a, 0xd0, 0xa6, 0xc3, 0xb4, 0x03,
+    0x5f, 0x45, 0x36, 0xbe, 0x3a, 0x50, 0xf3, 0x18,
+    0xfb, 0xf9, 0xa5, 0x47, 0x59, 0x02, 0xa2, 0x21,
+    0x50, 0x2b, 0xef, 0x0d, 0x57, 0xe0, 0x8c, 0x53,
+    0xb2, 0xcc, 0x0a, 0x56, 0xf1, 0x7d, 0x9f, 0x93,
+    0x54
+};
+
+static int is_base64url_char(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '_';
+}
+
+// Checks that an accepted token is three canonical Base64URL segments whose
+// payload segment is exactly the encoding of the returned payload
+static int is_canonical_jws(const uint8_t* data, size_t size, const uint8_t* payload, size_t payload_len) {
+    size_t dots[2];
+    size_t dot_count = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == '.') {
+            if (dot_count == 2) {
+                return 0;
+            }
+            dots[dot_count++] = i;
+        } else if (!is_base64url_char(data[i])) {
+            return 0;
+        }
+    }
+    if (dot_count != 2) {
+        return 0;
+    }
+    
+    char encoded[(512 / 3 + 1) * 4 + 1];
+    if (lcore_b64url_encode(payload, payload_len, encoded, sizeof(encoded)) != 0) {
+        return 0;
+    }
+    size_t segment_len = dots[1] - dots[0] - 1;
+    if (strlen(encoded) != segment_len || memcmp(encoded, data + dots[0] + 1, segment_len) != 0) {
+        return 0;
+    }
+    
+    // Header and signature must also be in their only accepted form
+    size_t decoded_len;
+    return lcore_b64url_decoded_len((const char*)data, dots[0], &decoded_len) == 0 &&
+           lcore_b64url_decoded_len((const char*)data + dots[1] + 1, size - dots[1] - 1, &decoded_len) == 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const char* jws = (const char*)data;
+    
+    // Single verification must never read past the input or overflow the payload buffer
+    uint8_t payload[512];
+    size_t payload_len = sizeof(payload);
+    int single = lcore_jose_verify(jws, size, test_verify_key, sizeof(test_verify_key),
+                                   payload, &payload_len);
+    if (single == 0 && payload_len > sizeof(payload)) {
+        abort();
+    }
+    
+    // Property: an accepted token has no other spelling ('+', '/', '=' or stray bits)
+    if (single == 0 && !is_canonical_jws(data, size, payload, payload_len)) {
+        abort();
+    }
+    
+    // Property: the batch path agrees with the single path, item by item
+    uint8_t batch_payloads[2][512];
+    size_t batch_lens[2] = { sizeof(batch_payloads[0]), sizeof(batch_payloads[1]) };
+    lcore_jose_verify_item_t items[2];
+    int results[2];
+    for (int i = 0; i < 2; i++) {
+        items[i].jws = jws;
+        items[i].jws_len = size;
+        items[i].public_key = test_verify_key;
+        items[i].key_len = sizeof(test_verify_key);
+        items[i].payload_buffer = batch_payloads[i];
+        items[i].payload_len = &batch_lens[i];
+    }
+    
+    int batch = lcore_jose_verify_batch(items, 2, results);
+    if ((batch == 0) != (single == 0) || (results[0] == 0) != (single == 0) || results[0] != results[1]) {
+        abort();
+    }
+    if (single == 0 && (batch_lens[0] != payload_len || memcmp(batch_payloads[0], payload, payload_len) != 0)) {
+        abort();
+    }
+    
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jose/jws.h"
+
+// Parse-only counterpart of fuzz_jose_verify: runs the split and decode path
+// of lcore_jose_verify() without the ECDSA check, so its throughput tracks
+// the parser alone.
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const char* jws = (const char*)data;
+    
+    lcore_jws_parts_t parts;
+    if (lcore_jws_parse(jws, size, &parts) != 0) {
+        return 0;
+    }
+    
+    // Property: the separators lie inside the token and delimit non-empty segments
+    if (parts.header_end == 0 || parts.payload_end <= parts.header_end + 1 || parts.payload_end + 1 >= size ||
+        jws[parts.header_end] != '.' || jws[parts.payload_end] != '.') {
+        abort();
+    }
+    if (parts.signature_len > sizeof(parts.signature)) {
+        abort();
+    }
+    
+    // Decoding the payload must stay within the buffer
+    uint8_t payload[512];
+    size_t payload_len = sizeof(payload);
+    if (lcore_jws_decode_payload(jws, &parts, payload, &payload_len) == 0 && payload_len > sizeof(payload)) {
+        abort();
+    }
+    
+    return 0;
+}
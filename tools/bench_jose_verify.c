@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <lcore/jose.h>
+#include <lcore/key.h>
+
+#define DEFAULT_TOKENS 200
+#define DEFAULT_DEVICES 64
+#define JWS_MAX 2048
+#define PAYLOAD_MAX 1024
+#define REPEATS 5
+
+// Benchmark devices are provisioned under consecutive ids from here and removed on exit
+#define BENCH_KEY_BASE 0x00004c00
+
+// Devices that send most of the traffic in the mixed workload
+#define HOT_DEVICES 4
+
+typedef struct {
+    uint8_t public_key[65];
+} bench_device_t;
+
+typedef enum {
+    WORKLOAD_SINGLE,      // every token from one device
+    WORKLOAD_INTERLEAVED, // devices take turns, as seen by a gateway
+    WORKLOAD_MIXED,       // 80% from a few hot devices, the rest spread over all others
+} workload_t;
+
+static const char* workload_names[] = {
+    "1 device",
+    "N devices interleaved",
+    "mixed (80% from 4 devices)",
+};
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Device that signed token i in the given workload
+static size_t device_for_token(workload_t workload, size_t i, size_t devices) {
+    switch (workload) {
+        case WORKLOAD_SINGLE:
+            return 0;
+        case WORKLOAD_INTERLEAVED:
+            return i % devices;
+        case WORKLOAD_MIXED:
+        default:
+            if (i % 5 != 0) {
+                return i % HOT_DEVICES;
+            }
+            return HOT_DEVICES + (i / 5) % (devices - HOT_DEVICES);
+    }
+}
+
+// Stores one key pair per device and exports its public key
+static int provision_devices(bench_device_t* devices, size_t count) {
+    for (size_t d = 0; d < count; d++) {
+        uint8_t private_key[32];
+        for (size_t j = 0; j < sizeof(private_key); j++) {
+            private_key[j] = (uint8_t)(j + 1);
+        }
+        private_key[30] = (uint8_t)(d >> 8);
+        private_key[31] = (uint8_t)d;
+
+        lcore_key_id_t key_id = BENCH_KEY_BASE + (lcore_key_id_t)d;
+        int result = lcore_key_provision(key_id, private_key, sizeof(private_key));
+        if (result == -3) {
+            // Left over from an interrupted run
+            lcore_key_destroy(key_id);
+            result = lcore_key_provision(key_id, private_key, sizeof(private_key));
+        }
+
+        size_t public_key_len = sizeof(devices[d].public_key);
+        if (result != 0 || lcore_key_export_public(key_id, devices[d].public_key, &public_key_len) != 0) {
+            printf("❌ Provisioning failed for device %zu\n", d);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void remove_devices(size_t count) {
+    for (size_t d = 0; d < count; d++) {
+        lcore_key_destroy(BENCH_KEY_BASE + (lcore_key_id_t)d);
+    }
+}
+
+// Signs one reading per token and times serial vs batch verification (best of REPEATS)
+static int run_workload(
+    workload_t workload,
+    const bench_device_t* devices,
+    size_t device_count,
+    size_t count,
+    char* tokens,
+    size_t* token_lens,
+    uint8_t* payloads,
+    size_t* payload_lens,
+    lcore_jose_verify_item_t* items,
+    int* results
+) {
+    for (size_t i = 0; i < count; i++) {
+        size_t d = device_for_token(workload, i, device_count);
+        char sensor_data[128];
+        snprintf(sensor_data, sizeof(sensor_data),
+            "{\"temperature\":%d.%d,\"humidity\":%d,\"seq\":%zu}",
+            20 + (int)(i % 10), (int)(i % 10), 40 + (int)(i % 20), i);
+
+        token_lens[i] = JWS_MAX;
+        if (lcore_jose_sign_with_key((const uint8_t*)sensor_data, strlen(sensor_data),
+                                     BENCH_KEY_BASE + (lcore_key_id_t)d,
+                                     LCORE_JOSE_ALG_ES256,
+                                     &tokens[i * JWS_MAX], &token_lens[i]) != 0) {
+            printf("❌ Signing failed at token %zu\n", i);
+            return -1;
+        }
+
+        items[i].jws = &tokens[i * JWS_MAX];
+        items[i].jws_len = token_lens[i];
+        items[i].public_key = devices[d].public_key;
+        items[i].key_len = sizeof(devices[d].public_key);
+        items[i].payload_buffer = &payloads[i * PAYLOAD_MAX];
+        items[i].payload_len = &payload_lens[i];
+    }
+
+    double serial = 0.0;
+    double batch = 0.0;
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        // Serial loop over lcore_jose_verify
+        double start = now_seconds();
+        for (size_t i = 0; i < count; i++) {
+            size_t payload_len = PAYLOAD_MAX;
+            if (lcore_jose_verify(items[i].jws, items[i].jws_len,
+                                  items[i].public_key, items[i].key_len,
+                                  &payloads[i * PAYLOAD_MAX], &payload_len) != 0) {
+                printf("❌ Serial verification failed at token %zu\n", i);
+                return -1;
+            }
+        }
+        double elapsed = now_seconds() - start;
+        if (repeat == 0 || elapsed < serial) {
+            serial = elapsed;
+        }
+
+        // One lcore_jose_verify_batch call
+        for (size_t i = 0; i < count; i++) {
+            payload_lens[i] = PAYLOAD_MAX;
+        }
+        start = now_seconds();
+        int result = lcore_jose_verify_batch(items, count, results);
+        elapsed = now_seconds() - start;
+        if (result != 0) {
+            printf("❌ Batch verification failed\n");
+            return -1;
+        }
+        if (repeat == 0 || elapsed < batch) {
+            batch = elapsed;
+        }
+    }
+
+    printf("📋 Workload: %s\n", workload_names[workload]);
+    printf("📏 Serial: %8.1f us/token  %8.0f tokens/s\n",
+           serial * 1e6 / count, count / serial);
+    printf("📏 Batch:  %8.1f us/token  %8.0f tokens/s\n",
+           batch * 1e6 / count, count / batch);
+    printf("🚀 Speedup: %.2fx\n\n", serial / batch);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    printf("⏱️  JWS Verification Benchmark (serial vs batch)\n");
+    printf("================================================\n\n");
+
+    size_t count = DEFAULT_TOKENS;
+    if (argc > 1) {
+        count = (size_t)strtoul(argv[1], NULL, 10);
+        if (count == 0) {
+            count = DEFAULT_TOKENS;
+        }
+    }
+    size_t device_count = DEFAULT_DEVICES;
+    if (argc > 2) {
+        device_count = (size_t)strtoul(argv[2], NULL, 10);
+        if (device_count <= HOT_DEVICES) {
+            device_count = DEFAULT_DEVICES;
+        }
+    }
+
+    char* tokens = malloc(count * JWS_MAX);
+    size_t* token_lens = malloc(count * sizeof(size_t));
+    uint8_t* payloads = malloc(count * PAYLOAD_MAX);
+    size_t* payload_lens = malloc(count * sizeof(size_t));
+    lcore_jose_verify_item_t* items = malloc(count * sizeof(lcore_jose_verify_item_t));
+    int* results = malloc(count * sizeof(int));
+    bench_device_t* devices = malloc(device_count * sizeof(bench_device_t));
+    if (!tokens || !token_lens || !payloads || !payload_lens || !items || !results || !devices) {
+        printf("❌ Out of memory\n");
+        return 1;
+    }
+
+    int status = 0;
+    if (provision_devices(devices, device_count) != 0) {
+        status = 1;
+    } else {
+        printf("📋 Tokens: %zu, devices: %zu, best of %d runs\n\n", count, device_count, REPEATS);
+        for (int w = WORKLOAD_SINGLE; w <= WORKLOAD_MIXED && status == 0; w++) {
+            if (run_workload((workload_t)w, devices, device_count, count,
+                             tokens, token_lens, payloads, payload_lens, items, results) != 0) {
+                status = 1;
+            }
+        }
+    }
+    remove_devices(device_count);
+
+    free(tokens);
+    free(token_lens);
+    free(payloads);
+    free(payload_lens);
+    free(items);
+    free(results);
+    free(devices);
+    return status;
+}
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <lcore/claims.h>
+#include <lcore/delta.h>
+#include <lcore/jose.h>
+
+// Same test private key as functional test
+static const uint8_t test_private_key[32] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20
+};
+
+#define DEFAULT_READINGS 1000
+#define KEYFRAME_INTERVAL 32
+
+// Envelope around the JWS in submit_sensor_data, before hex encoding
+#define ENVELOPE_OVERHEAD (sizeof("{\"type\":\"submit_sensor_data\",\"device_id\":\"did:lcore:00000000000000000000000000000000\",\"encrypted_payload\":\"\"}") - 1)
+
+typedef struct {
+    size_t payload_bytes;
+    size_t jws_bytes;
+    size_t wire_bytes;
+    double stage_seconds;
+    double inverse_seconds;
+} pipeline_stats_t;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Random-walk environmental reading, as produced by a real sensor loop
+static size_t next_reading(char* json, size_t json_size, unsigned* seed, double* temperature, int* humidity) {
+    *temperature += ((int)(rand_r(seed) % 5) - 2) * 0.1;
+    *humidity += (int)(rand_r(seed) % 3) - 1;
+    
+    size_t len = json_size;
+    lcore_claims_t claims;
+    lcore_claims_init(&claims, json, json_size);
+    lcore_claims_add_double(&claims, "temperature", *temperature, 1);
+    lcore_claims_add_int(&claims, "humidity", *humidity);
+    lcore_claims_add_string(&claims, "location", "test_lab");
+    lcore_claims_add_string(&claims, "device_type", "environmental_sensor");
+    lcore_claims_finish(&claims, &len);
+    return len;
+}
+
+static int sign_and_measure(const uint8_t* payload, size_t payload_len, pipeline_stats_t* stats) {
+    char jws[2048];
+    size_t jws_len = sizeof(jws);
+    if (lcore_jose_sign(payload, payload_len, test_private_key, sizeof(test_private_key),
+                        LCORE_JOSE_ALG_ES256, jws, &jws_len) != 0) {
+        return -1;
+    }
+    
+    stats->payload_bytes += payload_len;
+    stats->jws_bytes += jws_len;
+    stats->wire_bytes += 2 + 2 * (ENVELOPE_OVERHEAD + jws_len); // "0x" + hex
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    printf("⏱️  Sensor Payload Pipeline Benchmark (JSON vs delta)\n");
+    printf("===================================================\n\n");
+    
+    size_t count = DEFAULT_READINGS;
+    if (argc > 1) {
+        count = (size_t)strtoul(argv[1], NULL, 10);
+        if (count == 0) {
+            count = DEFAULT_READINGS;
+        }
+    }
+    
+    pipeline_stats_t plain = { 0, 0, 0, 0.0, 0.0 };
+    pipeline_stats_t delta = { 0, 0, 0, 0.0, 0.0 };
+    lcore_delta_ctx_t encoder;
+    lcore_delta_ctx_t decoder;
+    lcore_delta_init(&encoder, KEYFRAME_INTERVAL);
+    lcore_delta_init(&decoder, KEYFRAME_INTERVAL);
+    
+    unsigned seed = 42;
+    double temperature = 25.0;
+    int humidity = 48;
+    
+    for (size_t i = 0; i < count; i++) {
+        char json[256];
+        size_t json_len = next_reading(json, sizeof(json), &seed, &temperature, &humidity);
+        
+        // 1. Plain JSON payload
+        if (sign_and_measure((const uint8_t*)json, json_len, &plain) != 0) {
+            printf("❌ Signing failed at reading %zu\n", i);
+            return 1;
+        }
+        
+        // 2. Delta frame payload, decoded again as the node would after verification
+        uint8_t frame[256];
+        size_t frame_len = sizeof(frame);
+        double start = now_seconds();
+        if (lcore_delta_encode(&encoder, json, json_len, frame, &frame_len) != 0) {
+            printf("❌ Delta encoding failed at reading %zu\n", i);
+            return 1;
+        }
+        delta.stage_seconds += now_seconds() - start;
+        
+        if (sign_and_measure(frame, frame_len, &delta) != 0) {
+            printf("❌ Signing failed at reading %zu\n", i);
+            return 1;
+        }
+        
+        char decoded[256];
+        size_t decoded_len = sizeof(decoded);
+        start = now_seconds();
+        if (lcore_delta_decode(&decoder, frame, frame_len, decoded, &decoded_len) != 0) {
+            printf("❌ Delta decoding failed at reading %zu\n", i);
+            return 1;
+        }
+        delta.inverse_seconds += now_seconds() - start;
+    }
+    
+    printf("📋 Readings: %zu (keyframe every %d)\n\n", count, KEYFRAME_INTERVAL);
+    printf("%-8s %12s %12s %12s\n", "Payload", "bytes", "JWS bytes", "wire bytes");
+    printf("%-8s %12.1f %12.1f %12.1f\n", "JSON",
+           (double)plain.payload_bytes / count, (double)plain.jws_bytes / count, (double)plain.wire_bytes / count);
+    printf("%-8s %12.1f %12.1f %12.1f\n", "Delta",
+           (double)delta.payload_bytes / count, (double)delta.jws_bytes / count, (double)delta.wire_bytes / count);
+    printf("\n📏 Wire size: %.1f%% of JSON\n", 100.0 * delta.wire_bytes / plain.wire_bytes);
+    printf("📏 Delta encode: %.2f us/reading\n", delta.stage_seconds * 1e6 / count);
+    printf("📏 Delta decode: %.2f us/reading\n\n", delta.inverse_seconds * 1e6 / count);
+    
+    return 0;
+}